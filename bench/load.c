@@ -0,0 +1,476 @@
+// bench/load.c
+// Synthetic memory load for exercising freed: anonymous allocation patterns,
+// page cache streams, transparent huge pages and mlock.
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/utils.h"
+
+#define PATTERN_RAMP 0
+#define PATTERN_SAWTOOTH 1
+#define PATTERN_BURST 2
+
+#define FILE_NONE 0
+#define FILE_READ 1
+#define FILE_WRITE 2
+
+#define HUGE_PAGE_SIZE (2UL * 1024 * 1024)
+#define IO_CHUNK_SIZE (1024 * 1024)
+#define DEFAULT_SIZE (256UL * 1024 * 1024)
+#define DEFAULT_PERIOD_MS 10000
+#define DEFAULT_STEP_MS 100
+#define REPORT_INTERVAL_MS 1000
+
+typedef struct {
+    int pattern;
+    unsigned long size;         // peak anonymous bytes
+    int period_ms;              // length of one ramp/sawtooth/burst cycle
+    int step_ms;
+    int duration_ms;            // 0: until interrupted
+    bool thp;
+    bool lock;
+    const char *cgroup;
+    const char *file_path;
+    int file_mode;
+    unsigned long file_size;
+} LoadOptions;
+
+typedef struct {
+    char *base;
+    unsigned long size;
+    unsigned long resident;     // bytes touched from base upwards
+    long page_size;
+    bool lock;
+} AnonRegion;
+
+typedef struct {
+    int fd;
+    int mode;
+    unsigned long size;
+    unsigned long offset;
+    unsigned long per_step;     // bytes streamed each step
+    unsigned long total;        // bytes streamed so far
+    char *buf;
+} FileStream;
+
+static volatile sig_atomic_t keep_running = 1;
+
+static void signal_handler(int signum) {
+    (void)signum;
+    keep_running = 0;
+}
+
+static void show_usage(void) {
+    printf("Usage: freed-load [OPTIONS]\n");
+    printf("Generate a reproducible memory load for exercising freed.\n\n");
+    printf("  --pattern P         ramp, sawtooth or burst anonymous allocation (default ramp)\n");
+    printf("  --size SIZE         peak anonymous memory, e.g. 512M or 2G (default 256M)\n");
+    printf("  --period SECONDS    length of one allocation cycle (default %d)\n", DEFAULT_PERIOD_MS / 1000);
+    printf("  --step SECONDS      time between allocation steps (default %.1f)\n", DEFAULT_STEP_MS / 1000.0);
+    printf("  --duration SECONDS  stop after SECONDS (default: until interrupted)\n");
+    printf("  --thp               madvise(MADV_HUGEPAGE) the anonymous region\n");
+    printf("  --mlock             lock touched pages in RAM\n");
+    printf("  --file PATH         stream PATH through the page cache\n");
+    printf("  --file-mode MODE    read an existing PATH as is, or write (create or\n");
+    printf("                      truncate) it (default read)\n");
+    printf("  --file-size SIZE    bytes written in write mode (default 256M)\n");
+    printf("  --cgroup DIR        move into cgroup v2 directory DIR before allocating\n");
+    printf("  --help              display this help and exit\n\n");
+    printf("Prints one key=value line per second on stdout.\n");
+}
+
+// "512M", "2G", "4096": binary suffixes K, M, G, T
+static bool parse_size(const char *str, unsigned long *result) {
+    char *endptr;
+    errno = 0;
+
+    double val = strtod(str, &endptr);
+    if (errno == ERANGE || endptr == str || val < 0) {
+        return false;
+    }
+
+    switch (*endptr) {
+        case 'T': case 't': val *= 1024;    /* fall through */
+        case 'G': case 'g': val *= 1024;    /* fall through */
+        case 'M': case 'm': val *= 1024;    /* fall through */
+        case 'K': case 'k': val *= 1024; endptr++; break;
+        case '\0': break;
+        default: return false;
+    }
+    if (*endptr != '\0' && strcmp(endptr, "iB") != 0 && strcmp(endptr, "B") != 0) {
+        return false;
+    }
+
+    *result = (unsigned long)val;
+    return true;
+}
+
+static bool parse_seconds(const char *str, int *result_ms) {
+    char *endptr;
+    errno = 0;
+
+    double val = strtod(str, &endptr);
+    if (errno == ERANGE || endptr == str || *endptr != '\0' || val < 0 || val > 86400 * 30) {
+        return false;
+    }
+    *result_ms = (int)(val * 1000 + 0.5);
+    return true;
+}
+
+static bool parse_options(int argc, char **argv, LoadOptions *opts) {
+    static struct option long_options[] = {
+        {"pattern",   required_argument, 0, 'p'},
+        {"size",      required_argument, 0, 'z'},
+        {"period",    required_argument, 0, 'P'},
+        {"step",      required_argument, 0, 's'},
+        {"duration",  required_argument, 0, 'd'},
+        {"thp",       no_argument,       0, 'T'},
+        {"mlock",     no_argument,       0, 'L'},
+        {"file",      required_argument, 0, 'f'},
+        {"file-size", required_argument, 0, 'F'},
+        {"file-mode", required_argument, 0, 'M'},
+        {"cgroup",    required_argument, 0, 'C'},
+        {"help",      no_argument,       0, 'H'},
+        {0, 0, 0, 0}
+    };
+
+    memset(opts, 0, sizeof(*opts));
+    opts->size = DEFAULT_SIZE;
+    opts->period_ms = DEFAULT_PERIOD_MS;
+    opts->step_ms = DEFAULT_STEP_MS;
+    opts->file_size = DEFAULT_SIZE;
+
+    int opt;
+    bool ok = true;
+    const char *file_mode = "read";
+
+    while ((opt = getopt_long(argc, argv, "", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'p':
+                if (strcmp(optarg, "ramp") == 0) {
+                    opts->pattern = PATTERN_RAMP;
+                } else if (strcmp(optarg, "sawtooth") == 0) {
+                    opts->pattern = PATTERN_SAWTOOTH;
+                } else if (strcmp(optarg, "burst") == 0) {
+                    opts->pattern = PATTERN_BURST;
+                } else {
+                    fprintf(stderr, "Error: Unknown pattern '%s'\n", optarg);
+                    ok = false;
+                }
+                break;
+            case 'z':
+                if (!parse_size(optarg, &opts->size)) {
+                    fprintf(stderr, "Error: Invalid value for --size\n");
+                    ok = false;
+                }
+                break;
+            case 'P':
+                if (!parse_seconds(optarg, &opts->period_ms) || opts->period_ms == 0) {
+                    fprintf(stderr, "Error: Invalid value for --period\n");
+                    ok = false;
+                }
+                break;
+            case 's':
+                if (!parse_seconds(optarg, &opts->step_ms) || opts->step_ms == 0) {
+                    fprintf(stderr, "Error: Invalid value for --step\n");
+                    ok = false;
+                }
+                break;
+            case 'd':
+                if (!parse_seconds(optarg, &opts->duration_ms)) {
+                    fprintf(stderr, "Error: Invalid value for --duration\n");
+                    ok = false;
+                }
+                break;
+            case 'T':
+                opts->thp = true;
+                break;
+            case 'L':
+                opts->lock = true;
+                break;
+            case 'f':
+                opts->file_path = optarg;
+                break;
+            case 'F':
+                if (!parse_size(optarg, &opts->file_size) || opts->file_size == 0) {
+                    fprintf(stderr, "Error: Invalid value for --file-size\n");
+                    ok = false;
+                }
+                break;
+            case 'M':
+                file_mode = optarg;
+                break;
+            case 'C':
+                opts->cgroup = optarg;
+                break;
+            case 'H':
+                show_usage();
+                exit(EXIT_SUCCESS);
+            default:
+                ok = false;
+                break;
+        }
+    }
+
+    if (optind < argc) {
+        fprintf(stderr, "Error: Unexpected argument '%s'\n", argv[optind]);
+        ok = false;
+    }
+    if (strcmp(file_mode, "read") == 0) {
+        opts->file_mode = opts->file_path ? FILE_READ : FILE_NONE;
+    } else if (strcmp(file_mode, "write") == 0) {
+        opts->file_mode = opts->file_path ? FILE_WRITE : FILE_NONE;
+    } else {
+        fprintf(stderr, "Error: --file-mode must be read or write\n");
+        ok = false;
+    }
+    return ok;
+}
+
+// cgroup v2: a process joins a group by writing its pid to cgroup.procs
+static bool join_cgroup(const char *dir) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/cgroup.procs", dir);
+
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    fprintf(fp, "%d\n", (int)getpid());
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "Error joining cgroup %s: %s\n", dir, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+static bool anon_init(AnonRegion *region, const LoadOptions *opts) {
+    memset(region, 0, sizeof(*region));
+    region->page_size = sysconf(_SC_PAGESIZE);
+    region->size = opts->size;
+    region->lock = opts->lock;
+    if (region->size == 0) {
+        return true;
+    }
+
+    // Over-reserve so the region can start on a huge page boundary
+    unsigned long reserve = region->size + (opts->thp ? HUGE_PAGE_SIZE : 0);
+    char *base = mmap(NULL, reserve, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error: Failed to reserve %lu bytes: %s\n", reserve, strerror(errno));
+        return false;
+    }
+
+    if (opts->thp) {
+        base = (char *)(((unsigned long)base + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+        if (madvise(base, region->size, MADV_HUGEPAGE) != 0) {
+            fprintf(stderr, "Warning: MADV_HUGEPAGE failed: %s\n", strerror(errno));
+        }
+    }
+    region->base = base;
+    return true;
+}
+
+// Grow or shrink the touched prefix of the region to target bytes
+static void anon_resize(AnonRegion *region, unsigned long target) {
+    target -= target % region->page_size;
+
+    if (target > region->resident) {
+        char *start = region->base + region->resident;
+        unsigned long len = target - region->resident;
+
+        // One write per page makes the kernel fault in a private page
+        for (unsigned long off = 0; off < len; off += region->page_size) {
+            start[off] = (char)off;
+        }
+        if (region->lock && mlock(start, len) != 0) {
+            fprintf(stderr, "Warning: mlock failed (%s), continuing unlocked\n", strerror(errno));
+            region->lock = false;
+        }
+    } else if (target < region->resident) {
+        char *start = region->base + target;
+        unsigned long len = region->resident - target;
+
+        // Locked pages cannot be discarded until they are unlocked
+        if (region->lock) {
+            munlock(start, len);
+        }
+        madvise(start, len, MADV_DONTNEED);
+    }
+    region->resident = target;
+}
+
+// Bytes the pattern wants resident at time t into the run
+static unsigned long pattern_target(const LoadOptions *opts, uint64_t t_ms) {
+    uint64_t phase = t_ms % opts->period_ms;
+    double fraction;
+
+    switch (opts->pattern) {
+        case PATTERN_SAWTOOTH:
+            fraction = (double)phase / opts->period_ms;
+            break;
+        case PATTERN_BURST:
+            // Idle for the first half of each cycle, fully allocated for the second
+            fraction = phase >= (uint64_t)opts->period_ms / 2 ? 1.0 : 0.0;
+            break;
+        default:
+            fraction = t_ms >= (uint64_t)opts->period_ms ? 1.0 : (double)t_ms / opts->period_ms;
+            break;
+    }
+    return (unsigned long)(opts->size * fraction);
+}
+
+static bool file_init(FileStream *stream, const LoadOptions *opts) {
+    memset(stream, 0, sizeof(*stream));
+    stream->fd = -1;
+    stream->mode = opts->file_mode;
+    if (stream->mode == FILE_NONE) {
+        return true;
+    }
+
+    // Read mode never modifies the file; only write mode creates or overwrites it
+    if (stream->mode == FILE_READ) {
+        stream->fd = open(opts->file_path, O_RDONLY | O_CLOEXEC);
+    } else {
+        // Truncate so a longer file left by an earlier run keeps no stale tail
+        stream->fd = open(opts->file_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    }
+    if (stream->fd < 0) {
+        fprintf(stderr, "Error opening %s: %s\n", opts->file_path, strerror(errno));
+        return false;
+    }
+
+    if (stream->mode == FILE_READ) {
+        struct stat st;
+        if (fstat(stream->fd, &st) != 0) {
+            fprintf(stderr, "Error reading %s: %s\n", opts->file_path, strerror(errno));
+            return false;
+        }
+        if (st.st_size == 0) {
+            fprintf(stderr, "Error: %s is empty; nothing to read\n", opts->file_path);
+            return false;
+        }
+        stream->size = (unsigned long)st.st_size;
+        posix_fadvise(stream->fd, 0, 0, POSIX_FADV_DONTNEED);
+    } else {
+        stream->size = opts->file_size;
+    }
+
+    stream->per_step = (unsigned long)((double)stream->size * opts->step_ms / opts->period_ms);
+    if (stream->per_step == 0) stream->per_step = 1;
+
+    stream->buf = malloc(IO_CHUNK_SIZE);
+    if (stream->buf == NULL) {
+        fprintf(stderr, "Error: Failed to allocate I/O buffer\n");
+        return false;
+    }
+    memset(stream->buf, 'f', IO_CHUNK_SIZE);
+    return true;
+}
+
+// Stream the next slice of the file; dropping it from the cache on every
+// wrap keeps the page cache churning instead of settling
+static void file_step(FileStream *stream) {
+    unsigned long remaining = stream->per_step;
+
+    while (remaining > 0 && keep_running) {
+        if (stream->offset >= stream->size) {
+            stream->offset = 0;
+            if (stream->mode == FILE_WRITE) fdatasync(stream->fd);
+            posix_fadvise(stream->fd, 0, 0, POSIX_FADV_DONTNEED);
+        }
+
+        unsigned long len = remaining < IO_CHUNK_SIZE ? remaining : IO_CHUNK_SIZE;
+        if (len > stream->size - stream->offset) len = stream->size - stream->offset;
+
+        ssize_t n = stream->mode == FILE_WRITE
+            ? pwrite(stream->fd, stream->buf, len, stream->offset)
+            : pread(stream->fd, stream->buf, len, stream->offset);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            fprintf(stderr, "Warning: file stream stopped: %s\n", n < 0 ? strerror(errno) : "EOF");
+            stream->mode = FILE_NONE;
+            return;
+        }
+
+        stream->offset += n;
+        stream->total += n;
+        remaining -= n;
+    }
+}
+
+static void file_close(FileStream *stream) {
+    if (stream->fd >= 0) close(stream->fd);
+    free(stream->buf);
+}
+
+int main(int argc, char **argv) {
+    LoadOptions opts;
+    AnonRegion region;
+    FileStream stream;
+
+    if (!parse_options(argc, argv, &opts)) {
+        fprintf(stderr, "Try 'freed-load --help' for more information.\n");
+        return EXIT_FAILURE;
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    // Join the cgroup first so every page below is charged to it
+    if (opts.cgroup != NULL && !join_cgroup(opts.cgroup)) {
+        return EXIT_FAILURE;
+    }
+    if (!anon_init(&region, &opts)) {
+        return EXIT_FAILURE;
+    }
+    if (!file_init(&stream, &opts)) {
+        file_close(&stream);
+        return EXIT_FAILURE;
+    }
+
+    const uint64_t start_ns = monotonic_ns();
+    uint64_t next_report_ms = 0;
+
+    while (keep_running) {
+        uint64_t t_ms = (monotonic_ns() - start_ns) / 1000000;
+        if (opts.duration_ms > 0 && t_ms >= (uint64_t)opts.duration_ms) {
+            break;
+        }
+
+        if (region.size > 0) {
+            anon_resize(&region, pattern_target(&opts, t_ms));
+        }
+        if (stream.mode != FILE_NONE) {
+            file_step(&stream);
+        }
+
+        if (t_ms >= next_report_ms) {
+            printf("t_ms=%llu anon=%lu file_bytes=%lu\n",
+                   (unsigned long long)t_ms, region.resident, stream.total);
+            fflush(stdout);
+            next_report_ms = t_ms + REPORT_INTERVAL_MS;
+        }
+
+        // Keep a fixed cadence regardless of how long the step took
+        uint64_t elapsed_ms = (monotonic_ns() - start_ns) / 1000000 - t_ms;
+        if (elapsed_ms < (uint64_t)opts.step_ms) {
+            sleep_ms(opts.step_ms - (int)elapsed_ms);
+        }
+    }
+
+    anon_resize(&region, 0);
+    file_close(&stream);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+// bench/procio_bench.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glob.h>
+#include "../include/procio.h"
+#include "../include/utils.h"
+
+#define DEFAULT_TICKS 2000
+
+// Files a busy tick reads: core counters, PSI, per-node meminfo and cgroup stats
+static const char *const BENCH_PATTERNS[] = {
+    "/proc/meminfo",
+    "/proc/vmstat",
+    "/proc/swaps",
+    "/proc/pressure/memory",
+    "/sys/devices/system/node/node*/meminfo",
+    "/sys/block/zram*/mm_stat",
+    "/sys/fs/cgroup/memory.current",
+    "/sys/fs/cgroup/memory.stat",
+    "/sys/fs/cgroup/memory.pressure",
+    "/sys/fs/cgroup/*/memory.current",
+    "/sys/fs/cgroup/*/memory.stat",
+};
+
+static int register_files(void) {
+    int registered = 0;
+
+    for (size_t i = 0; i < sizeof(BENCH_PATTERNS) / sizeof(BENCH_PATTERNS[0]); i++) {
+        glob_t matches;
+        if (glob(BENCH_PATTERNS[i], 0, NULL, &matches) != 0) {
+            continue;
+        }
+        for (size_t j = 0; j < matches.gl_pathc; j++) {
+            if (procio_register(matches.gl_pathv[j]) >= 0) {
+                registered++;
+            }
+        }
+        globfree(&matches);
+    }
+    return registered;
+}
+
+static void run_backend(int requested, const char *name, int ticks) {
+    if (!procio_init(requested)) {
+        exit(EXIT_FAILURE);
+    }
+    if (requested != procio_backend()) {
+        printf("%-8s unavailable\n", name);
+        procio_shutdown();
+        return;
+    }
+
+    int files = register_files();
+    procio_begin_tick();    // warm-up: opens are done, first batch primes caches
+
+    const ProcioStats before = *procio_stats();
+    uint64_t start_ns = monotonic_ns();
+    for (int i = 0; i < ticks; i++) {
+        procio_begin_tick();
+    }
+    uint64_t elapsed_ns = monotonic_ns() - start_ns;
+    const ProcioStats *after = procio_stats();
+
+    printf("%-8s %6d %14.1f %12.1f %14.1f\n", name, files,
+           (double)(after->syscalls - before.syscalls) / ticks,
+           (double)elapsed_ns / ticks / 1000.0,
+           (double)(after->bytes - before.bytes) / ticks);
+
+    procio_shutdown();
+}
+
+int main(int argc, char **argv) {
+    int ticks = argc > 1 ? atoi(argv[1]) : DEFAULT_TICKS;
+    if (ticks <= 0) {
+        fprintf(stderr, "Usage: %s [TICKS]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%-8s %6s %14s %12s %14s\n", "BACKEND", "FILES", "SYSCALLS/TICK", "US/TICK", "BYTES/TICK");
+    run_backend(PROCIO_BACKEND_PREAD, "pread", ticks);
+    run_backend(PROCIO_BACKEND_URING, "io_uring", ticks);
+    return EXIT_SUCCESS;
+}
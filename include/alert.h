@@ -0,0 +1,31 @@
+#ifndef ALERT_H
+#define ALERT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "memory.h"
+
+#define MAX_ALERT_RULES 32
+#define ALERT_EXPR_MAX 128
+#define ALERT_EXIT_STATUS 2
+
+/*
+ * Alert rules have the form
+ *
+ *     FIELD OP VALUE[unit] [for DURATION]
+ *     FIELD OP PERCENT% [of FIELD] [for DURATION]
+ *
+ * e.g. "available < 5% of total for 3s" or "swap_used > 2G".  Rules are
+ * compiled once into a field offset, comparison and threshold so that
+ * evaluating them per sample is a handful of loads and compares.
+ */
+bool alert_add_rule(const char *expr);
+void alert_set_hook(const char *command);
+int alert_rule_count(void);
+bool alert_uses_field(const char *name);
+
+// Evaluate all rules against a sample; returns the number of rules that triggered
+int alert_evaluate(const MemoryInfo *info, uint64_t now_ns);
+int alert_exit_status(void);
+
+#endif /* ALERT_H */
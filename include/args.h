@@ -3,15 +3,40 @@
 
 #include "common.h"
 
+// Which view display_loop() renders
+#define VIEW_MEMORY 0
+#define VIEW_LEAKS 1
+#define VIEW_SLAB 2
+#define VIEW_FINCORE 3
+#define VIEW_SMAPS 4
+#define VIEW_BREAKDOWN 5
+#define VIEW_ZONES 6
+
 typedef struct {
     int display_mode;    // 0: normal, 1: deluxe
     int unit;           // 0: auto, 1: bytes, 2: KB, 3: MB, 4: GB, 5: TB
-    int repeat_seconds; // 0: no repeat, >0: seconds between updates
+    int repeat_ms;      // 0: no repeat, >0: milliseconds between updates
     int repeat_count;   // 0: infinite, >0: number of repeats
     int wide_output;    // 0: normal, 1: wide
     int show_total;     // 0: no total, 1: show total
     int single_line;    // 0: normal, 1: single line
     int si_units;       // 0: power of 1024, 1: power of 1000
+    int quiet;          // 0: print samples, 1: only print alert events
+    int alert_exit;     // 0: keep running, 1: exit when an alert triggers
+    int adaptive_min_ms;        // 0: fixed interval, >0: adaptive lower bound
+    int adaptive_max_ms;        // adaptive upper bound
+    double adaptive_threshold;  // churn/stall percent per second that counts as activity
+    int view;           // VIEW_* constant
+    int leak_window;    // seconds of history in the leak trend
+    int leak_cap;       // max tracked processes for --leaks
+    const char *slabinfo_path;  // slabinfo source for --slab
+    char **fincore_paths;       // files and directories for --fincore
+    int fincore_path_count;
+    int pid;                    // process for --pid
+    int io_backend;             // PROCIO_BACKEND_* for per-tick procfs reads
+    int profile;                // 1: time each loop stage and report on exit
+    int probe_pages;            // 0: no allocation probe, >0: pages faulted per sample
+    int forecast;               // 1: estimate when available memory and swap run out
 } ProgramOptions;
 
 ProgramOptions parse_args(int argc, char **argv);
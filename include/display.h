@@ -2,10 +2,21 @@
 #define DISPLAY_H
 
 #include "memory.h"
+#include "swap.h"
+#include "fincore.h"
+#include "smaps.h"
+#include "zones.h"
 #include "args.h"
 
-void display_memory(MemoryInfo *info, ProgramOptions *opts);
-void display_memory_deluxe(MemoryInfo *info, ProgramOptions *opts);
+void display_memory(MemoryInfo *info, SwapDetails *swap, ProgramOptions *opts);
+void display_memory_deluxe(MemoryInfo *info, SwapDetails *swap, ProgramOptions *opts);
+void display_memory_line(MemoryInfo *info, ProgramOptions *opts);
+void display_breakdown(MemoryInfo *info, ProgramOptions *opts);
+void display_leaks(ProgramOptions *opts);
+void display_slab(MemoryInfo *info, ProgramOptions *opts);
+void display_fincore(const FincoreReport *report, ProgramOptions *opts);
+void display_smaps(const SmapsSummary *summary, ProgramOptions *opts);
+void display_zones(const ZoneReport *report, ProgramOptions *opts);
 // Remove the declaration of format_size from here
 void show_loading_animation(void);
 
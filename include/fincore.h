@@ -0,0 +1,36 @@
+#ifndef FINCORE_H
+#define FINCORE_H
+
+#include <stdbool.h>
+#include <limits.h>
+
+#define FINCORE_TOP_COUNT 20
+#define FINCORE_MAX_THREADS 16
+
+// A file or directory ranked by how much of it is in the page cache
+typedef struct {
+    char path[PATH_MAX];
+    unsigned long size;
+    unsigned long cached;
+} FincoreEntry;
+
+typedef struct {
+    FincoreEntry top_files[FINCORE_TOP_COUNT];
+    int top_file_count;
+    FincoreEntry top_dirs[FINCORE_TOP_COUNT];   // whole subtrees
+    int top_dir_count;
+    unsigned long files;
+    unsigned long dirs;
+    unsigned long errors;
+    unsigned long unknown;      // files whose residency the kernel would not reveal
+    unsigned long total_size;
+    unsigned long total_cached;
+    double elapsed_s;
+} FincoreReport;
+
+// Walk the given files and directory trees and measure page cache residency
+// with cachestat(), or mincore() on older kernels; never reads file data, so
+// scanning does not populate the cache
+const FincoreReport *fincore_scan(char *const *paths, int count);
+
+#endif /* FINCORE_H */
@@ -0,0 +1,35 @@
+#ifndef FORECAST_H
+#define FORECAST_H
+
+#include <stdint.h>
+#include <limits.h>
+#include "memory.h"
+
+#define FORECAST_NEVER ULONG_MAX        // ETA when the series is not declining
+#define FORECAST_MIN_SAMPLES 5          // samples before an ETA is reported
+#define FORECAST_ALPHA 0.3              // level smoothing per sample
+#define FORECAST_BETA 0.1               // trend smoothing per sample
+#define FORECAST_Z 1.96                 // two-sided 95% bounds
+
+// Holt double-exponential smoothing over an irregularly sampled series.
+// The trend is in bytes per second; the variances are exponentially weighted
+// one-step residuals of the level and of the observed slope.
+typedef struct {
+    double level;
+    double trend;
+    double level_var;
+    double slope_var;
+    uint64_t last_ns;
+    unsigned long samples;
+} HoltSeries;
+
+// Time-to-exhaustion forecaster for available memory and free swap
+typedef struct {
+    HoltSeries available;
+    HoltSeries swap_free;
+} Forecaster;
+
+void forecast_init(Forecaster *forecaster);
+void forecast_update(Forecaster *forecaster, MemoryInfo *info, uint64_t now_ns);
+
+#endif /* FORECAST_H */
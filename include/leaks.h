@@ -0,0 +1,31 @@
+#ifndef LEAKS_H
+#define LEAKS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define DEFAULT_LEAK_WINDOW 300     // seconds of history weighted into the trend
+#define DEFAULT_LEAK_CAP 32768      // tracked processes before eviction
+#define MAX_LEAK_CAP 1048576
+#define LEAK_TOP_COUNT 15
+
+// A process whose RSS is growing steadily, as reported by leaks_top()
+typedef struct {
+    pid_t pid;
+    char comm[16];
+    unsigned long rss;
+    double slope;           // bytes per second, weighted over the window
+    double monotonic;       // 0..1 share of recent samples that did not shrink
+    double tracked_s;       // how long the process has been observed
+} LeakReport;
+
+bool leaks_init(int window_s, int cap);
+void leaks_sample(uint64_t now_ns);
+int leaks_top(LeakReport *out, int max);
+int leaks_tracked(void);
+size_t leaks_state_bytes(void);
+void leaks_free(void);
+
+#endif /* LEAKS_H */
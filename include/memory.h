@@ -12,8 +12,50 @@ typedef struct {
     unsigned long swap_total;
     unsigned long swap_used;
     unsigned long swap_free;
+    unsigned long zswap;        // compressed pool size held in RAM by zswap
+    unsigned long zswapped;     // uncompressed size of pages stored in zswap
+    unsigned long slab_reclaimable;
+    unsigned long slab_unreclaimable;
+    unsigned long interval_ms;  // measured time since the previous sample, 0 for the first
+    unsigned long fault_pages;  // pages timed by the allocation probe, 0 when it is off
+    unsigned long fault_p50_ns;
+    unsigned long fault_p99_ns;
+    unsigned long fault_max_ns;
+    unsigned long forecast_samples;         // samples fed to the forecaster, 0 when it is off
+    unsigned long available_eta_s;          // seconds until available runs out, ULONG_MAX if never
+    unsigned long available_eta_low_s;      // 95% bounds of the ETA
+    unsigned long available_eta_high_s;
+    unsigned long swap_free_eta_s;
+    unsigned long swap_free_eta_low_s;
+    unsigned long swap_free_eta_high_s;
+
+    // Raw meminfo counters used only by the --breakdown partition
+    unsigned long page_cache;   // Cached: page cache including shmem, excluding SReclaimable
+    unsigned long swap_cached;
+    unsigned long anon_pages;
+    unsigned long kernel_stack;
+    unsigned long page_tables;
+    unsigned long sec_page_tables;
+    unsigned long vmalloc_used;
+    unsigned long percpu;
+    unsigned long hugetlb;
 } MemoryInfo;
 
+#define MEMORY_PART_MAX 16
+
+typedef struct {
+    const char *name;
+    unsigned long bytes;
+} MemoryPart;
+
+// Disjoint components of MemTotal plus whatever the kernel does not report
+typedef struct {
+    MemoryPart parts[MEMORY_PART_MAX];
+    int count;
+    long unaccounted;           // MemTotal minus the sum of parts; negative if fields overlap
+} MemoryBreakdown;
+
 MemoryInfo get_memory_info(void);
+void memory_breakdown(const MemoryInfo *info, MemoryBreakdown *breakdown);
 
 #endif /* MEMORY_H */
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef PROBE_H
+#define PROBE_H
+
+#include <stdbool.h>
+#include "memory.h"
+
+#define MAX_PROBE_PAGES 16384       // 64 MiB with 4 KiB pages
+
+/*
+ * Allocation-latency probe: each sample maps a fresh anonymous region,
+ * faults in every page while timing each fault, then unmaps it.  Fault
+ * times grow when the page allocator has to reclaim or compact first, so
+ * they show direct-reclaim stalls that "available" does not.  The full
+ * page count is faulted in and released on every sample, so the cost
+ * scales with both the page count and the sampling rate.
+ */
+bool probe_init(int pages);
+bool probe_run(MemoryInfo *info);
+void probe_free(void);
+
+#endif /* PROBE_H */
@@ -0,0 +1,39 @@
+#ifndef PROCIO_H
+#define PROCIO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PROCIO_MAX_FILES 64
+#define PROCIO_BUFFER_SIZE (16 * 1024)  // per file; larger files belong to LineStream
+
+#define PROCIO_BACKEND_PREAD 0
+#define PROCIO_BACKEND_URING 1
+
+/*
+ * Sampling layer for small procfs/sysfs files that are re-read every tick.
+ * Files are opened once and kept open.  procio_begin_tick() reads every
+ * registered file in one batch (a single io_uring_enter() with the uring
+ * backend, one pread() per file otherwise) and procio_read() then returns
+ * the buffered contents.  Files first read mid-tick are read on demand and
+ * join the batch from the next tick.  A file that fills its whole buffer is
+ * reported once and read as failing with EFBIG instead of being truncated.
+ */
+typedef struct {
+    unsigned long ticks;
+    unsigned long syscalls;     // read-path syscalls: pread, io_uring_enter, or
+                                // read() by other collectors via procio_count()
+    unsigned long reads;
+    unsigned long bytes;
+} ProcioStats;
+
+bool procio_init(int backend);
+int procio_backend(void);
+int procio_register(const char *path);
+void procio_begin_tick(void);
+const char *procio_read(int handle, size_t *len);
+void procio_count(size_t bytes);
+const ProcioStats *procio_stats(void);
+void procio_shutdown(void);
+
+#endif /* PROCIO_H */
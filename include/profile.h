@@ -0,0 +1,47 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "utils.h"
+
+// Stages of one display_loop() tick
+#define PROF_READ 0     // batched procfs reads
+#define PROF_PARSE 1    // meminfo parsing, alerts, swap details and view collectors
+#define PROF_PROBE 2    // --probe page faults, excluded from parse
+#define PROF_FORMAT 3   // format_size() calls, summed per tick
+#define PROF_BUILD 4    // rendering into the stdout buffer, excluding format_size()
+#define PROF_WRITE 5    // flushing the frame to the terminal
+#define PROF_STAGE_COUNT 6
+
+/*
+ * --profile keeps one log-linear latency histogram per stage (fixed size,
+ * 8 sub-buckets per power of two) and prints p50/p99/max on exit.  When
+ * profiling is off each probe costs one predicted-not-taken branch; building
+ * with -DNO_PROFILE removes the probes entirely.
+ */
+extern bool profile_enabled;
+
+#ifdef NO_PROFILE
+#define PROFILE_BEGIN() ((uint64_t)0)
+#define PROFILE_END(stage, start) ((void)(start))
+#define PROFILE_COUNT_WRITE() ((void)0)
+#define PROFILE_END_TICK() ((void)0)
+#else
+#define PROFILE_BEGIN() (__builtin_expect(profile_enabled, 0) ? monotonic_ns() : 0)
+#define PROFILE_END(stage, start) \
+    do { if (__builtin_expect(profile_enabled, 0)) profile_add((stage), (start)); } while (0)
+#define PROFILE_COUNT_WRITE() \
+    do { if (__builtin_expect(profile_enabled, 0)) profile_count_write(); } while (0)
+#define PROFILE_END_TICK() \
+    do { if (__builtin_expect(profile_enabled, 0)) profile_end_tick(); } while (0)
+#endif
+
+void profile_init(void);
+void profile_add(int stage, uint64_t start_ns);
+void profile_count_write(void);
+void profile_end_tick(void);
+void profile_report(FILE *out);
+
+#endif /* PROFILE_H */
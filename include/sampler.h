@@ -0,0 +1,28 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "memory.h"
+
+#define DEFAULT_ADAPTIVE_THRESHOLD 1.0  // percent of total per second
+#define ADAPTIVE_BACKOFF_DIVISOR 2      // interval grows by 1/N while the host is stable
+
+// Adaptive interval scheduler: drops to min_ms under memory churn or PSI
+// stalls and backs off exponentially towards max_ms while the host is idle.
+typedef struct {
+    int min_ms;
+    int max_ms;
+    int current_ms;
+    double threshold;               // churn/stall percentage that counts as activity
+    MemoryInfo prev;
+    uint64_t prev_ns;
+    bool have_prev;
+    unsigned long long prev_stall_us;
+    bool have_psi;
+} AdaptiveSampler;
+
+void sampler_init(AdaptiveSampler *sampler, int min_ms, int max_ms, double threshold);
+int sampler_next_interval(AdaptiveSampler *sampler, const MemoryInfo *info, uint64_t now_ns);
+
+#endif /* SAMPLER_H */
@@ -0,0 +1,27 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SLABINFO_PATH "/proc/slabinfo"
+#define SLAB_NAME_MAX 64
+#define SLAB_TOP_COUNT 20
+
+// One cache line of /proc/slabinfo
+typedef struct {
+    char name[SLAB_NAME_MAX];
+    unsigned long active_objs;
+    unsigned long num_objs;
+    unsigned long objsize;
+    unsigned long bytes;        // num_slabs * pagesperslab * page size
+    double growth;              // bytes per second since the previous sample
+} SlabCache;
+
+bool slab_sample(const char *path, uint64_t now_ns);
+int slab_top(SlabCache *out, int max);
+int slab_cache_count(void);
+unsigned long slab_total_bytes(void);
+void slab_free(void);
+
+#endif /* SLAB_H */
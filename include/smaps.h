@@ -0,0 +1,34 @@
+#ifndef SMAPS_H
+#define SMAPS_H
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+#define SMAPS_TOP_COUNT 20
+#define SMAPS_MAX_MAPPINGS 4096     // distinct names; the rest fold into "[other]"
+#define SMAPS_NAME_ARENA (512 * 1024)
+
+// Totals for all VMAs sharing one name (file path, [heap], [anon], ...)
+typedef struct {
+    const char *name;
+    unsigned long vmas;
+    unsigned long rss;
+    unsigned long pss;
+    unsigned long private_dirty;
+    unsigned long swap;
+    unsigned long anon_huge;
+} SmapsMapping;
+
+typedef struct {
+    pid_t pid;
+    char comm[16];
+    SmapsMapping total;
+    int mapping_count;
+    unsigned long bytes_parsed;
+    double elapsed_s;
+} SmapsSummary;
+
+bool smaps_read(pid_t pid, SmapsSummary *summary);
+int smaps_top(SmapsMapping *out, int max);
+
+#endif /* SMAPS_H */
@@ -0,0 +1,24 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define STREAM_CHUNK_SIZE (256 * 1024)
+
+// Line reader over a file using one fixed chunk buffer, so memory stays
+// constant however large the file is (smaps, zoneinfo)
+typedef struct {
+    int fd;
+    char *buf;
+    size_t start;           // first unread byte
+    size_t end;             // one past the last buffered byte
+    bool eof;
+    size_t bytes_read;
+} LineStream;
+
+bool stream_open(LineStream *stream, const char *path);
+char *stream_next_line(LineStream *stream, size_t *len);
+void stream_close(LineStream *stream);
+
+#endif /* STREAM_H */
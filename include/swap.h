@@ -0,0 +1,43 @@
+#ifndef SWAP_H
+#define SWAP_H
+
+#include <stdbool.h>
+#include <limits.h>
+#include "memory.h"
+
+#define MAX_SWAP_DEVICES 32
+#define MAX_ZRAM_DEVICES 16
+#define SWAP_NAME_MAX PATH_MAX
+
+// One row of /proc/swaps
+typedef struct {
+    char name[SWAP_NAME_MAX];
+    char type[16];          // "partition", "file" or "zram"
+    unsigned long size;
+    unsigned long used;
+    int priority;
+} SwapDevice;
+
+// Compression statistics from /sys/block/zramN/mm_stat
+typedef struct {
+    char name[16];
+    unsigned long orig_data_size;   // uncompressed bytes stored
+    unsigned long compr_data_size;  // compressed bytes stored
+    unsigned long mem_used_total;   // RAM actually consumed, allocator overhead included
+} ZramDevice;
+
+typedef struct {
+    SwapDevice devices[MAX_SWAP_DEVICES];
+    int device_count;
+    ZramDevice zram[MAX_ZRAM_DEVICES];
+    int zram_count;
+    unsigned long zswap;        // compressed pool size (from MemoryInfo)
+    unsigned long zswapped;     // uncompressed bytes held by zswap
+} SwapDetails;
+
+bool get_swap_details(const MemoryInfo *info, SwapDetails *details);
+const ZramDevice *find_zram_device(const SwapDetails *details, const SwapDevice *dev);
+double compression_ratio(unsigned long orig, unsigned long compressed);
+unsigned long swap_ram_cost(const SwapDetails *details);
+
+#endif /* SWAP_H */
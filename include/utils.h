@@ -2,10 +2,13 @@
 #define UTILS_H
 
 #include <stddef.h>  // For size_t
+#include <stdint.h>
 #include "args.h"
 
 void cleanup(void);
 void setup_terminal(void);
 void format_size(unsigned long bytes, char *result, size_t result_size, const ProgramOptions *opts);
+uint64_t monotonic_ns(void);
+void sleep_ms(int ms);
 
 #endif /* UTILS_H */
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef ZONES_H
+#define ZONES_H
+
+#include <stdbool.h>
+
+#define ZONEINFO_PATH "/proc/zoneinfo"
+#define BUDDYINFO_PATH "/proc/buddyinfo"
+#define ZONES_MAX 1024              // populated node/zone pairs kept per sample
+#define ZONE_ORDERS 16              // buddy orders tracked; kernels use 11 by default
+#define ZONE_NAME_MAX 16
+
+// One populated zone of one NUMA node; counts are in pages
+typedef struct {
+    int node;
+    char name[ZONE_NAME_MAX];
+    unsigned long free;
+    unsigned long min;              // below: allocations enter direct reclaim
+    unsigned long low;              // below: kswapd is woken
+    unsigned long high;             // kswapd reclaims until free is back above
+    unsigned long managed;
+    int orders;                     // orders reported by buddyinfo, 0 if the zone is missing there
+    unsigned long blocks[ZONE_ORDERS];      // free blocks of 2^order pages
+    double unusable[ZONE_ORDERS];   // share of free pages unusable for an order-N allocation
+} ZoneStats;
+
+typedef struct {
+    ZoneStats zones[ZONES_MAX];
+    int count;
+    unsigned long page_size;
+    unsigned long bytes_parsed;
+    double elapsed_s;
+} ZoneReport;
+
+// Stream zoneinfo for watermarks and join buddyinfo free lists by node and zone
+const ZoneReport *zones_read(const char *zoneinfo_path, const char *buddyinfo_path);
+
+#endif /* ZONES_H */
@@ -0,0 +1,372 @@
+// src/alert.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stddef.h>     // For offsetof macro
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "../include/alert.h"
+#include "../include/common.h"
+
+#define NS_PER_MS 1000000ULL
+#define TOKEN_MAX 32
+
+typedef enum {
+    OP_LT,
+    OP_LE,
+    OP_GT,
+    OP_GE,
+    OP_EQ,
+    OP_NE
+} AlertOp;
+
+// Compiled form of a rule: lhs OP (rhs_const [* rhs field])
+typedef struct {
+    size_t lhs_offset;
+    size_t rhs_offset;      // only used when rhs_is_field
+    bool rhs_is_field;
+    AlertOp op;
+    double rhs_const;       // bytes, or a fraction of the rhs field
+    uint64_t hold_ns;       // condition must hold this long before triggering
+    uint64_t pending_since; // 0 while the condition is false
+    bool active;
+    char expr[ALERT_EXPR_MAX];
+} AlertRule;
+
+// Sample fields that rules may refer to
+typedef struct {
+    const char *name;
+    size_t offset;
+} AlertField;
+
+static const AlertField ALERT_FIELDS[] = {
+    {"total",      offsetof(MemoryInfo, total)},
+    {"used",       offsetof(MemoryInfo, used)},
+    {"free",       offsetof(MemoryInfo, free)},
+    {"shared",     offsetof(MemoryInfo, shared)},
+    {"buffers",    offsetof(MemoryInfo, buffers)},
+    {"cached",     offsetof(MemoryInfo, cached)},
+    {"available",  offsetof(MemoryInfo, available)},
+    {"swap_total", offsetof(MemoryInfo, swap_total)},
+    {"swap_used",  offsetof(MemoryInfo, swap_used)},
+    {"swap_free",  offsetof(MemoryInfo, swap_free)},
+    {"zswap",      offsetof(MemoryInfo, zswap)},
+    {"zswapped",   offsetof(MemoryInfo, zswapped)},
+    {"slab_reclaimable",   offsetof(MemoryInfo, slab_reclaimable)},
+    {"slab_unreclaimable", offsetof(MemoryInfo, slab_unreclaimable)},
+    {"fault_p50_ns", offsetof(MemoryInfo, fault_p50_ns)},
+    {"fault_p99_ns", offsetof(MemoryInfo, fault_p99_ns)},
+    {"fault_max_ns", offsetof(MemoryInfo, fault_max_ns)},
+    {"available_eta_s", offsetof(MemoryInfo, available_eta_s)},
+    {"swap_free_eta_s", offsetof(MemoryInfo, swap_free_eta_s)}
+};
+#define ALERT_FIELD_COUNT (sizeof(ALERT_FIELDS) / sizeof(ALERT_FIELDS[0]))
+
+static const char *const OP_NAMES[] = {"<", "<=", ">", ">=", "==", "!="};
+
+static AlertRule rules[MAX_ALERT_RULES];
+static int rule_count = 0;
+static const char *hook_command = NULL;
+static bool any_triggered = false;
+
+// Split the next token off *pos: an identifier, a number with unit, an operator or '%'
+static bool next_token(const char **pos, char *token) {
+    const char *p = *pos;
+    int len = 0;
+
+    while (isspace((unsigned char)*p)) p++;
+    if (*p == '\0') {
+        return false;
+    }
+
+    if (isalnum((unsigned char)*p) || *p == '.' || *p == '_') {
+        while ((isalnum((unsigned char)*p) || *p == '.' || *p == '_') && len < TOKEN_MAX - 1) {
+            token[len++] = *p++;
+        }
+    } else if (strchr("<>=!", *p)) {
+        while (*p && strchr("<>=!", *p) && len < TOKEN_MAX - 1) {
+            token[len++] = *p++;
+        }
+    } else {
+        token[len++] = *p++;
+    }
+
+    token[len] = '\0';
+    *pos = p;
+    return true;
+}
+
+static bool lookup_field(const char *name, size_t *offset) {
+    for (size_t i = 0; i < ALERT_FIELD_COUNT; i++) {
+        if (strcmp(ALERT_FIELDS[i].name, name) == 0) {
+            *offset = ALERT_FIELDS[i].offset;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool lookup_op(const char *name, AlertOp *op) {
+    for (size_t i = 0; i < sizeof(OP_NAMES) / sizeof(OP_NAMES[0]); i++) {
+        if (strcmp(OP_NAMES[i], name) == 0) {
+            *op = (AlertOp)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse "512M", "2GiB", "1048576" into bytes (binary multiples, like the display)
+static bool parse_bytes(const char *token, double *bytes) {
+    char *end;
+    errno = 0;
+    double val = strtod(token, &end);
+    // strtod accepts "nan" and "inf", which no sample can ever cross
+    if (errno != 0 || end == token || !isfinite(val) || val < 0) {
+        return false;
+    }
+
+    double scale = 1;
+    const char *multiples = "KMGT";
+    const char *unit = *end ? strchr(multiples, toupper((unsigned char)*end)) : NULL;
+    if (unit != NULL) {
+        for (const char *m = multiples; m <= unit; m++) {
+            scale *= 1024.0;
+        }
+        end++;
+    }
+
+    // Accept an optional "B" or "iB" after the multiple
+    if (strcmp(end, "") != 0 && strcasecmp(end, "B") != 0 && strcmp(end, "iB") != 0) {
+        return false;
+    }
+
+    *bytes = val * scale;
+    return true;
+}
+
+// Parse "3s", "500ms", "2m" into nanoseconds
+static bool parse_duration(const char *token, uint64_t *ns) {
+    char *end;
+    errno = 0;
+    double val = strtod(token, &end);
+    if (errno != 0 || end == token || !isfinite(val) || val < 0) {
+        return false;
+    }
+
+    double ms;
+    if (strcmp(end, "ms") == 0) {
+        ms = val;
+    } else if (strcmp(end, "s") == 0 || *end == '\0') {
+        ms = val * 1000;
+    } else if (strcmp(end, "m") == 0) {
+        ms = val * 60 * 1000;
+    } else {
+        return false;
+    }
+
+    if (ms * NS_PER_MS >= (double)UINT64_MAX) {
+        return false;
+    }
+    *ns = (uint64_t)(ms * NS_PER_MS);
+    return true;
+}
+
+static bool compile_rule(const char *expr, AlertRule *rule) {
+    char token[TOKEN_MAX] = "";
+    const char *pos = expr;
+
+    memset(rule, 0, sizeof(*rule));
+
+    if (!next_token(&pos, token) || !lookup_field(token, &rule->lhs_offset)) {
+        fprintf(stderr, "Error: Unknown field '%s' in alert rule\n", token);
+        return false;
+    }
+    if (!next_token(&pos, token) || !lookup_op(token, &rule->op)) {
+        fprintf(stderr, "Error: Expected comparison operator in alert rule\n");
+        return false;
+    }
+
+    char value[TOKEN_MAX];
+    if (!next_token(&pos, value)) {
+        fprintf(stderr, "Error: Missing threshold in alert rule\n");
+        return false;
+    }
+
+    bool have_token = next_token(&pos, token);
+    if (have_token && strcmp(token, "%") == 0) {
+        // Percentage of another field, "of total" by default
+        char *end;
+        double percent = strtod(value, &end);
+        if (*end != '\0' || end == value || !isfinite(percent)) {
+            fprintf(stderr, "Error: Invalid threshold '%s%%' in alert rule\n", value);
+            return false;
+        }
+        rule->rhs_const = percent / 100.0;
+        rule->rhs_is_field = true;
+        rule->rhs_offset = offsetof(MemoryInfo, total);
+
+        have_token = next_token(&pos, token);
+        if (have_token && strcmp(token, "of") == 0) {
+            if (!next_token(&pos, token) || !lookup_field(token, &rule->rhs_offset)) {
+                fprintf(stderr, "Error: Unknown field '%s' in alert rule\n", token);
+                return false;
+            }
+            have_token = next_token(&pos, token);
+        }
+    } else if (!parse_bytes(value, &rule->rhs_const)) {
+        fprintf(stderr, "Error: Invalid threshold '%s' in alert rule\n", value);
+        return false;
+    }
+
+    if (have_token && strcmp(token, "for") == 0) {
+        if (!next_token(&pos, token) || !parse_duration(token, &rule->hold_ns)) {
+            fprintf(stderr, "Error: Invalid duration in alert rule\n");
+            return false;
+        }
+        have_token = next_token(&pos, token);
+    }
+
+    if (have_token) {
+        fprintf(stderr, "Error: Unexpected '%s' in alert rule\n", token);
+        return false;
+    }
+
+    snprintf(rule->expr, sizeof(rule->expr), "%s", expr);
+    return true;
+}
+
+bool alert_add_rule(const char *expr) {
+    if (rule_count >= MAX_ALERT_RULES) {
+        fprintf(stderr, "Error: At most %d alert rules are supported\n", MAX_ALERT_RULES);
+        return false;
+    }
+    if (!compile_rule(expr, &rules[rule_count])) {
+        return false;
+    }
+    rule_count++;
+    return true;
+}
+
+void alert_set_hook(const char *command) {
+    hook_command = command;
+}
+
+int alert_rule_count(void) {
+    return rule_count;
+}
+
+// Whether any rule reads the named field, on either side of the comparison
+bool alert_uses_field(const char *name) {
+    size_t offset;
+    if (!lookup_field(name, &offset)) {
+        return false;
+    }
+    for (int i = 0; i < rule_count; i++) {
+        if (rules[i].lhs_offset == offset || (rules[i].rhs_is_field && rules[i].rhs_offset == offset)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int alert_exit_status(void) {
+    return any_triggered ? ALERT_EXIT_STATUS : 0;
+}
+
+static inline unsigned long field_value(const MemoryInfo *info, size_t offset) {
+    return *(const unsigned long *)((const char *)info + offset);
+}
+
+static inline bool compare(double lhs, AlertOp op, double rhs) {
+    switch (op) {
+        case OP_LT: return lhs < rhs;
+        case OP_LE: return lhs <= rhs;
+        case OP_GT: return lhs > rhs;
+        case OP_GE: return lhs >= rhs;
+        case OP_EQ: return lhs == rhs;
+        case OP_NE: return lhs != rhs;
+    }
+    return false;
+}
+
+// Run the hook in the background with the event described in the environment
+static void run_hook(const char *event, int index, const AlertRule *rule,
+                     unsigned long value, double threshold) {
+    pid_t pid = fork();
+    if (pid == -1) {
+        fprintf(stderr, "Error: Failed to run alert hook: %s\n", strerror(errno));
+        return;
+    }
+    if (pid > 0) {
+        return;
+    }
+
+    char buf[32];
+    setenv("FREED_ALERT_EVENT", event, 1);
+    setenv("FREED_ALERT_EXPR", rule->expr, 1);
+    snprintf(buf, sizeof(buf), "%d", index + 1);
+    setenv("FREED_ALERT_RULE", buf, 1);
+    snprintf(buf, sizeof(buf), "%lu", value);
+    setenv("FREED_ALERT_VALUE", buf, 1);
+    snprintf(buf, sizeof(buf), "%.0f", threshold);
+    setenv("FREED_ALERT_THRESHOLD", buf, 1);
+
+    execl("/bin/sh", "sh", "-c", hook_command, (char *)NULL);
+    _exit(127);
+}
+
+static void emit_event(const char *event, int index, const AlertRule *rule,
+                       unsigned long value, double threshold) {
+    fprintf(stderr, "%s: alert event=%s rule=%d value=%lu threshold=%.0f expr=\"%s\"\n",
+            PROGRAM_NAME, event, index + 1, value, threshold, rule->expr);
+
+    if (hook_command != NULL) {
+        run_hook(event, index, rule, value, threshold);
+    }
+}
+
+int alert_evaluate(const MemoryInfo *info, uint64_t now_ns) {
+    int triggered = 0;
+
+    // Reap finished hooks without blocking
+    if (hook_command != NULL) {
+        while (waitpid(-1, NULL, WNOHANG) > 0) {
+            continue;
+        }
+    }
+
+    for (int i = 0; i < rule_count; i++) {
+        AlertRule *rule = &rules[i];
+        unsigned long lhs = field_value(info, rule->lhs_offset);
+        double rhs = rule->rhs_is_field
+            ? rule->rhs_const * field_value(info, rule->rhs_offset)
+            : rule->rhs_const;
+
+        if (!compare((double)lhs, rule->op, rhs)) {
+            rule->pending_since = 0;
+            if (rule->active) {
+                rule->active = false;
+                emit_event("clear", i, rule, lhs, rhs);
+            }
+            continue;
+        }
+
+        if (rule->pending_since == 0) {
+            rule->pending_since = now_ns;
+        }
+        if (!rule->active && now_ns - rule->pending_since >= rule->hold_ns) {
+            rule->active = true;
+            any_triggered = true;
+            triggered++;
+            emit_event("trigger", i, rule, lhs, rhs);
+        }
+    }
+
+    return triggered;
+}
@@ -5,13 +5,42 @@
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>
+#include <math.h>
 #include "../include/args.h"
 #include "../include/common.h"
 #include "../include/utils.h"
+#include "../include/alert.h"
+#include "../include/sampler.h"
+#include "../include/leaks.h"
+#include "../include/slab.h"
+#include "../include/procio.h"
+#include "../include/probe.h"
 
 #define MAX_SECONDS 3600
 #define MAX_COUNT 1000
 
+// Long-only options
+enum {
+    OPT_ALERT = 256,
+    OPT_ALERT_EXEC,
+    OPT_ALERT_EXIT,
+    OPT_ADAPTIVE,
+    OPT_ADAPTIVE_THRESHOLD,
+    OPT_LEAKS,
+    OPT_LEAK_WINDOW,
+    OPT_LEAK_CAP,
+    OPT_SLAB,
+    OPT_SLABINFO,
+    OPT_FINCORE,
+    OPT_PID,
+    OPT_IO_URING,
+    OPT_BREAKDOWN,
+    OPT_PROFILE,
+    OPT_PROBE,
+    OPT_ZONES,
+    OPT_FORECAST
+};
+
 static struct option long_options[] = {
     {"bytes",     no_argument,       0, 'b'},
     {"kilo",      no_argument,       0, 'k'},
@@ -24,6 +53,26 @@ static struct option long_options[] = {
     {"seconds",   required_argument, 0, 's'},
     {"count",     required_argument, 0, 'c'},
     {"wide",      no_argument,       0, 'w'},
+    {"quiet",     no_argument,       0, 'q'},
+    {"line",      no_argument,       0, 'l'},
+    {"adaptive",  required_argument, 0, OPT_ADAPTIVE},
+    {"adaptive-threshold", required_argument, 0, OPT_ADAPTIVE_THRESHOLD},
+    {"breakdown", no_argument,       0, OPT_BREAKDOWN},
+    {"leaks",     no_argument,       0, OPT_LEAKS},
+    {"leak-window", required_argument, 0, OPT_LEAK_WINDOW},
+    {"leak-cap",  required_argument, 0, OPT_LEAK_CAP},
+    {"slab",      no_argument,       0, OPT_SLAB},
+    {"slabinfo",  required_argument, 0, OPT_SLABINFO},
+    {"fincore",   no_argument,       0, OPT_FINCORE},
+    {"pid",       required_argument, 0, OPT_PID},
+    {"zones",     no_argument,       0, OPT_ZONES},
+    {"io-uring",  no_argument,       0, OPT_IO_URING},
+    {"profile",   no_argument,       0, OPT_PROFILE},
+    {"probe",     required_argument, 0, OPT_PROBE},
+    {"forecast",  no_argument,       0, OPT_FORECAST},
+    {"alert",     required_argument, 0, OPT_ALERT},
+    {"alert-exec", required_argument, 0, OPT_ALERT_EXEC},
+    {"alert-exit", no_argument,      0, OPT_ALERT_EXIT},
     {"help",      no_argument,       0, 'H'},
     {"version",   no_argument,       0, 'V'},
     {0, 0, 0, 0}
@@ -56,6 +105,47 @@ static int parse_number(const char *str, int *result, int min, int max) {
     return 0;
 }
 
+// Parse an interval in (possibly fractional) seconds into milliseconds
+static int handle_interval_arg(const char *optarg, int *target_ms, int max_seconds, const char *option_name) {
+    char *endptr;
+    errno = 0;
+
+    double val = strtod(optarg, &endptr);
+    // NaN fails every comparison, so it has to be rejected explicitly
+    if (errno == ERANGE || endptr == optarg || *endptr != '\0' || !isfinite(val) ||
+        val < 0 || val > max_seconds || (val > 0 && val < 0.001)) {
+        fprintf(stderr, "Error: Invalid value for --%s. Must be between 0.001 and %d\n",
+                option_name, max_seconds);
+        return -1;
+    }
+
+    *target_ms = (int)(val * 1000 + 0.5);
+    return 0;
+}
+
+// Parse "MIN:MAX" (seconds) into an adaptive interval range
+static int handle_adaptive_arg(const char *optarg, ProgramOptions *opts) {
+    char min_str[32];
+    const char *sep = strchr(optarg, ':');
+
+    if (sep == NULL || (size_t)(sep - optarg) >= sizeof(min_str)) {
+        fprintf(stderr, "Error: --adaptive expects MIN:MAX in seconds\n");
+        return -1;
+    }
+    memcpy(min_str, optarg, sep - optarg);
+    min_str[sep - optarg] = '\0';
+
+    if (handle_interval_arg(min_str, &opts->adaptive_min_ms, MAX_SECONDS, "adaptive") != 0 ||
+        handle_interval_arg(sep + 1, &opts->adaptive_max_ms, MAX_SECONDS, "adaptive") != 0) {
+        return -1;
+    }
+    if (opts->adaptive_min_ms == 0 || opts->adaptive_min_ms > opts->adaptive_max_ms) {
+        fprintf(stderr, "Error: --adaptive needs 0 < MIN <= MAX\n");
+        return -1;
+    }
+    return 0;
+}
+
 // Function to validate and handle numeric arguments
 static int handle_numeric_arg(const char *optarg, int *target, int min, int max, const char *option_name) {
     if (parse_number(optarg, target, min, max) != 0) {
@@ -88,6 +178,10 @@ static int check_exclusive_options(ProgramOptions *opts) {
 
 ProgramOptions parse_args(int argc, char **argv) {
     ProgramOptions opts = {0}; // Initialize all to 0
+    opts.adaptive_threshold = DEFAULT_ADAPTIVE_THRESHOLD;
+    opts.leak_window = DEFAULT_LEAK_WINDOW;
+    opts.leak_cap = DEFAULT_LEAK_CAP;
+    opts.slabinfo_path = SLABINFO_PATH;
     int option_index = 0;
     int c;
     int error = 0;
@@ -95,7 +189,7 @@ ProgramOptions parse_args(int argc, char **argv) {
     // Reset getopt
     optind = 1;
 
-    while ((c = getopt_long(argc, argv, "bkmgthds:c:wHVS",
+    while ((c = getopt_long(argc, argv, "bkmgthds:c:wqlHVS",
                            long_options, &option_index)) != -1) {
         switch (c) {
             case 'b': opts.unit = 1; break;
@@ -108,7 +202,7 @@ ProgramOptions parse_args(int argc, char **argv) {
             case 'S': opts.si_units = 1; break;
             
             case 's':
-                if (handle_numeric_arg(optarg, &opts.repeat_seconds, 0, MAX_SECONDS, "seconds") != 0) {
+                if (handle_interval_arg(optarg, &opts.repeat_ms, MAX_SECONDS, "seconds") != 0) {
                     error = 1;
                 }
                 break;
@@ -122,7 +216,108 @@ ProgramOptions parse_args(int argc, char **argv) {
             case 'w': 
                 opts.wide_output = 1; 
                 break;
+
+            case 'q':
+                opts.quiet = 1;
+                break;
+
+            case 'l':
+                opts.single_line = 1;
+                break;
+
+            case OPT_ADAPTIVE:
+                if (handle_adaptive_arg(optarg, &opts) != 0) {
+                    error = 1;
+                }
+                break;
+
+            case OPT_ADAPTIVE_THRESHOLD: {
+                char *endptr;
+                opts.adaptive_threshold = strtod(optarg, &endptr);
+                if (*endptr != '\0' || endptr == optarg || !isfinite(opts.adaptive_threshold) ||
+                    opts.adaptive_threshold <= 0) {
+                    fprintf(stderr, "Error: Invalid value for --adaptive-threshold\n");
+                    error = 1;
+                }
+                break;
+            }
+
+            case OPT_ALERT:
+                if (!alert_add_rule(optarg)) {
+                    error = 1;
+                }
+                break;
+
+            case OPT_ALERT_EXEC:
+                alert_set_hook(optarg);
+                break;
+
+            case OPT_ALERT_EXIT:
+                opts.alert_exit = 1;
+                break;
                 
+            case OPT_LEAKS:
+                opts.view = VIEW_LEAKS;
+                break;
+
+            case OPT_LEAK_WINDOW:
+                if (handle_numeric_arg(optarg, &opts.leak_window, 1, 7 * 24 * 3600, "leak-window") != 0) {
+                    error = 1;
+                }
+                break;
+
+            case OPT_LEAK_CAP:
+                if (handle_numeric_arg(optarg, &opts.leak_cap, 1, MAX_LEAK_CAP, "leak-cap") != 0) {
+                    error = 1;
+                }
+                break;
+
+            case OPT_BREAKDOWN:
+                opts.view = VIEW_BREAKDOWN;
+                break;
+
+            case OPT_SLAB:
+                opts.view = VIEW_SLAB;
+                break;
+
+            case OPT_SLABINFO:
+                opts.view = VIEW_SLAB;
+                opts.slabinfo_path = optarg;
+                break;
+
+            case OPT_FINCORE:
+                opts.view = VIEW_FINCORE;
+                break;
+
+            case OPT_PID:
+                opts.view = VIEW_SMAPS;
+                if (handle_numeric_arg(optarg, &opts.pid, 1, INT_MAX, "pid") != 0) {
+                    error = 1;
+                }
+                break;
+
+            case OPT_ZONES:
+                opts.view = VIEW_ZONES;
+                break;
+
+            case OPT_IO_URING:
+                opts.io_backend = PROCIO_BACKEND_URING;
+                break;
+
+            case OPT_PROBE:
+                if (handle_numeric_arg(optarg, &opts.probe_pages, 1, MAX_PROBE_PAGES, "probe") != 0) {
+                    error = 1;
+                }
+                break;
+
+            case OPT_FORECAST:
+                opts.forecast = 1;
+                break;
+
+            case OPT_PROFILE:
+                opts.profile = 1;
+                break;
+
             case 'H': 
                 show_help(); 
                 exit(EXIT_SUCCESS);
@@ -143,8 +338,16 @@ ProgramOptions parse_args(int argc, char **argv) {
         }
     }
 
-    // Check for non-option arguments
-    if (optind < argc) {
+    // --fincore takes the remaining arguments as paths
+    if (opts.view == VIEW_FINCORE) {
+        if (optind >= argc) {
+            fprintf(stderr, "Error: --fincore needs at least one file or directory\n");
+            error = 1;
+        }
+        opts.fincore_paths = argv + optind;
+        opts.fincore_path_count = argc - optind;
+    } else if (optind < argc) {
+        // Check for non-option arguments
         fprintf(stderr, "Error: Unexpected argument: %s\n", argv[optind]);
         error = 1;
     }
@@ -174,9 +377,34 @@ void show_help(void) {
     printf("  -h, --human         show human-readable output (default)\n");
     printf("  -d, --deluxe        show deluxe output with icons\n");
     printf("  -S, --si            use powers of 1000 not 1024\n");
-    printf("  -s N, --seconds N   repeat printing every N seconds (0-%d)\n", MAX_SECONDS);
+    printf("  -s N, --seconds N   repeat printing every N seconds (0-%d, fractions allowed)\n", MAX_SECONDS);
     printf("  -c N, --count N     repeat printing N times (0-%d, 0=infinite)\n", MAX_COUNT);
     printf("  -w, --wide          use wide output format\n");
+    printf("  -q, --quiet         print only alert events, not memory samples\n");
+    printf("  -l, --line          print each sample as one line of key=value pairs\n");
+    printf("  --adaptive MIN:MAX  sample every MIN..MAX seconds, faster under memory churn\n");
+    printf("  --adaptive-threshold PCT\n");
+    printf("                      churn or stall %% per second that counts as activity (default %.1f)\n",
+           DEFAULT_ADAPTIVE_THRESHOLD);
+    printf("  --alert RULE        alert when RULE holds, e.g. 'available < 5%% of total for 3s'\n");
+    printf("  --alert-exec CMD    run CMD via /bin/sh on every alert trigger or clear\n");
+    printf("  --alert-exit        exit with status %d as soon as an alert triggers\n", ALERT_EXIT_STATUS);
+    printf("  --breakdown         split total memory into kernel-reported components\n");
+    printf("  --leaks             watch for processes whose RSS grows steadily\n");
+    printf("  --leak-window N     seconds of history weighted into each trend (default %d)\n",
+           DEFAULT_LEAK_WINDOW);
+    printf("  --leak-cap N        max processes tracked; weakest trends evicted (default %d)\n",
+           DEFAULT_LEAK_CAP);
+    printf("  --slab              show the largest kernel slab caches\n");
+    printf("  --slabinfo FILE     read slab caches from FILE instead of %s\n", SLABINFO_PATH);
+    printf("  --fincore PATH...   show how much of each file and directory is in the page cache\n");
+    printf("  --pid PID           break down the memory of PID by mapping from its smaps\n");
+    printf("  --zones             show zone watermarks and buddy allocator fragmentation\n");
+    printf("  --io-uring          batch each tick's procfs reads through io_uring\n");
+    printf("  --probe PAGES       time page faults on PAGES fresh pages every sample (max %d)\n",
+           MAX_PROBE_PAGES);
+    printf("  --forecast          estimate when available memory and free swap run out\n");
+    printf("  --profile           report per-stage latency (p50/p99/max) on exit\n");
     printf("  -H, --help          display this help and exit\n");
     printf("  -V, --version       output version information and exit\n");
     printf("\n");
@@ -184,6 +412,13 @@ void show_help(void) {
     printf("  %s -d               show deluxe output with icons\n", PROGRAM_NAME);
     printf("  %s -h -s 1          show human-readable output, updating every second\n", PROGRAM_NAME);
     printf("  %s -m -w            show megabytes in wide format\n", PROGRAM_NAME);
+    printf("  %s -l --adaptive 0.1:10\n", PROGRAM_NAME);
+    printf("                      log samples, every 100 ms under churn, up to 10 s when idle\n");
+    printf("  %s --leaks -s 10    report growing processes every 10 seconds\n", PROGRAM_NAME);
+    printf("  %s --fincore /var/lib/db\n", PROGRAM_NAME);
+    printf("                      rank the database files by cached size\n");
+    printf("  %s -q -s 0.05 --alert 'swap_used > 1G'\n", PROGRAM_NAME);
+    printf("                      check a rule at 20 Hz, printing only events\n");
 }
 
 void show_version(void) {
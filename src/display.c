@@ -2,15 +2,30 @@
 #include <string.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <time.h>
 #include "../include/display.h"
 #include "../include/memory.h"
+#include "../include/swap.h"
+#include "../include/leaks.h"
+#include "../include/slab.h"
+#include "../include/forecast.h"
 #include "../include/args.h"
 #include "../include/common.h"
 #include "../include/utils.h" 
+#include "../include/profile.h"
+
+// format_size() as seen by --profile; utils.c stays free of the profiler
+static void format_size_timed(unsigned long bytes, char *result, size_t result_size,
+                              const ProgramOptions *opts) {
+    uint64_t start_ns = PROFILE_BEGIN();
+    format_size(bytes, result, result_size, opts);
+    PROFILE_END(PROF_FORMAT, start_ns);
+}
 
 // Spinner frames array
 static const char* SPINNER_FRAMES[] = {"⠋", "⠙", "⠹", "⠸", "⠼", "⠴", "⠦", "⠧", "⠇", "⠏"};
 #define SPINNER_FRAME_COUNT (sizeof(SPINNER_FRAMES) / sizeof(SPINNER_FRAMES[0]))
+#define FORECAST_BUFFER_SIZE 96
 
 // Unit strings for formatting
 static const char* UNITS[] = {"B", "KiB", "MiB", "GiB", "TiB"};
@@ -50,21 +65,93 @@ static void draw_memory_bar(double percentage, int width, const char* color) {
     printf("%s", bar_buffer);
 }
 
-void display_memory(MemoryInfo *info, ProgramOptions *opts) {
+// Per-device swap usage plus the compression efficiency of zram and zswap
+static void print_swap_details(const SwapDetails *swap, ProgramOptions *opts) {
+    char size[FORMAT_BUFFER_SIZE], used[FORMAT_BUFFER_SIZE], cost[FORMAT_BUFFER_SIZE];
+
+    if (swap->device_count > 0) {
+        printf("\nSwap Devices:\n"
+               "-------------\n");
+        for (int i = 0; i < swap->device_count; i++) {
+            const SwapDevice *dev = &swap->devices[i];
+            format_size_timed(dev->size, size, FORMAT_BUFFER_SIZE, opts);
+            format_size_timed(dev->used, used, FORMAT_BUFFER_SIZE, opts);
+            printf("%-20s %-10s prio %-5d %s / %s\n",
+                   dev->name, dev->type, dev->priority, used, size);
+        }
+    }
+
+    for (int i = 0; i < swap->zram_count; i++) {
+        const ZramDevice *zram = &swap->zram[i];
+        if (zram->orig_data_size == 0) continue;
+        format_size_timed(zram->orig_data_size, size, FORMAT_BUFFER_SIZE, opts);
+        format_size_timed(zram->compr_data_size, used, FORMAT_BUFFER_SIZE, opts);
+        format_size_timed(zram->mem_used_total, cost, FORMAT_BUFFER_SIZE, opts);
+        printf("%-20s %s stored as %s (%.2fx), RAM cost %s\n",
+               zram->name, size, used,
+               compression_ratio(zram->orig_data_size, zram->compr_data_size), cost);
+    }
+
+    if (swap->zswapped > 0) {
+        format_size_timed(swap->zswapped, size, FORMAT_BUFFER_SIZE, opts);
+        format_size_timed(swap->zswap, cost, FORMAT_BUFFER_SIZE, opts);
+        printf("%-20s %s stored in %s pool (%.2fx)\n",
+               "zswap", size, cost, compression_ratio(swap->zswapped, swap->zswap));
+    }
+
+    if (swap_ram_cost(swap) > 0) {
+        format_size_timed(swap_ram_cost(swap), cost, FORMAT_BUFFER_SIZE, opts);
+        printf("Compressed swap RAM: %s\n", cost);
+    }
+}
+
+// "45s", "14m", "3h 05m", "2d 4h"
+static void format_eta(unsigned long seconds, char *out, size_t size) {
+    if (seconds == FORECAST_NEVER) {
+        snprintf(out, size, "never");
+    } else if (seconds < 120) {
+        snprintf(out, size, "%lus", seconds);
+    } else if (seconds < 2 * 3600) {
+        snprintf(out, size, "%lum", seconds / 60);
+    } else if (seconds < 2 * 86400) {
+        snprintf(out, size, "%luh %02lum", seconds / 3600, seconds / 60 % 60);
+    } else {
+        snprintf(out, size, "%lud %luh", seconds / 86400, seconds / 3600 % 24);
+    }
+}
+
+// Forecast summary for one series: the ETA with its 95% bounds
+static void format_forecast(unsigned long samples, unsigned long eta, unsigned long low,
+                            unsigned long high, char *out, size_t size) {
+    char values[3][FORMAT_BUFFER_SIZE];
+
+    if (samples < FORECAST_MIN_SAMPLES) {
+        snprintf(out, size, "collecting samples (%lu/%d)", samples, FORECAST_MIN_SAMPLES);
+    } else if (eta == FORECAST_NEVER) {
+        snprintf(out, size, "not declining");
+    } else {
+        format_eta(eta, values[0], FORMAT_BUFFER_SIZE);
+        format_eta(low, values[1], FORMAT_BUFFER_SIZE);
+        format_eta(high, values[2], FORMAT_BUFFER_SIZE);
+        snprintf(out, size, "%s (95%%: %s - %s)", values[0], values[1], values[2]);
+    }
+}
+
+void display_memory(MemoryInfo *info, SwapDetails *swap, ProgramOptions *opts) {
     char total[FORMAT_BUFFER_SIZE], used[FORMAT_BUFFER_SIZE], 
          free[FORMAT_BUFFER_SIZE], available[FORMAT_BUFFER_SIZE], 
          cached[FORMAT_BUFFER_SIZE], swap_total[FORMAT_BUFFER_SIZE], 
          swap_used[FORMAT_BUFFER_SIZE], buffers[FORMAT_BUFFER_SIZE];
     
     // Format all sizes at once
-    format_size(info->total, total, FORMAT_BUFFER_SIZE, opts);
-    format_size(info->used, used, FORMAT_BUFFER_SIZE, opts);
-    format_size(info->free, free, FORMAT_BUFFER_SIZE, opts);
-    format_size(info->available, available, FORMAT_BUFFER_SIZE, opts);
-    format_size(info->cached, cached, FORMAT_BUFFER_SIZE, opts);
-    format_size(info->buffers, buffers, FORMAT_BUFFER_SIZE, opts);
-    format_size(info->swap_total, swap_total, FORMAT_BUFFER_SIZE, opts);
-    format_size(info->swap_used, swap_used, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->total, total, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->used, used, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->free, free, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->available, available, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->cached, cached, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->buffers, buffers, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->swap_total, swap_total, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->swap_used, swap_used, FORMAT_BUFFER_SIZE, opts);
     
     // Build output using a single buffer
     static char output_buffer[MAX_BUFFER_SIZE];
@@ -82,6 +169,33 @@ void display_memory(MemoryInfo *info, ProgramOptions *opts) {
         "Cached Memory:    %s\n",
         total, used, free, available, buffers, cached);
 
+    // Adaptive sampling varies the gap, so state it for rate calculations
+    if (opts->adaptive_min_ms > 0 && info->interval_ms > 0) {
+        offset += snprintf(output_buffer + offset, sizeof(output_buffer) - offset,
+            "Sample Interval:  %lu ms\n", info->interval_ms);
+    }
+
+    if (info->fault_pages > 0) {
+        offset += snprintf(output_buffer + offset, sizeof(output_buffer) - offset,
+            "Fault Latency:    p50 %.1f us, p99 %.1f us, max %.1f us (%lu pages)\n",
+            info->fault_p50_ns / 1e3, info->fault_p99_ns / 1e3, info->fault_max_ns / 1e3,
+            info->fault_pages);
+    }
+
+    if (info->forecast_samples > 0) {
+        char forecast[FORECAST_BUFFER_SIZE];
+        format_forecast(info->forecast_samples, info->available_eta_s, info->available_eta_low_s,
+                        info->available_eta_high_s, forecast, sizeof(forecast));
+        offset += snprintf(output_buffer + offset, sizeof(output_buffer) - offset,
+            "Available ETA:    %s\n", forecast);
+        if (info->swap_total > 0) {
+            format_forecast(info->forecast_samples, info->swap_free_eta_s, info->swap_free_eta_low_s,
+                            info->swap_free_eta_high_s, forecast, sizeof(forecast));
+            offset += snprintf(output_buffer + offset, sizeof(output_buffer) - offset,
+                "Swap Free ETA:    %s\n", forecast);
+        }
+    }
+
     // Add swap information if available
     if (info->swap_total > 0) {
         offset += snprintf(output_buffer + offset, sizeof(output_buffer) - offset,
@@ -94,23 +208,27 @@ void display_memory(MemoryInfo *info, ProgramOptions *opts) {
 
     // Write the complete buffer at once
     printf("%s", output_buffer);
+
+    if (swap != NULL) {
+        print_swap_details(swap, opts);
+    }
 }
 
-void display_memory_deluxe(MemoryInfo *info, ProgramOptions *opts) {
+void display_memory_deluxe(MemoryInfo *info, SwapDetails *swap, ProgramOptions *opts) {
     static char buffer[MAX_BUFFER_SIZE];
     int offset = 0;
     static int frame = 0;
 
     // Format all memory values at once
     char formatted[8][FORMAT_BUFFER_SIZE];
-    format_size(info->total, formatted[0], FORMAT_BUFFER_SIZE, opts);
-    format_size(info->used, formatted[1], FORMAT_BUFFER_SIZE, opts);
-    format_size(info->free, formatted[2], FORMAT_BUFFER_SIZE, opts);
-    format_size(info->available, formatted[3], FORMAT_BUFFER_SIZE, opts);
-    format_size(info->cached, formatted[4], FORMAT_BUFFER_SIZE, opts);
-    format_size(info->swap_total, formatted[5], FORMAT_BUFFER_SIZE, opts);
-    format_size(info->swap_used, formatted[6], FORMAT_BUFFER_SIZE, opts);
-    format_size(info->buffers, formatted[7], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->total, formatted[0], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->used, formatted[1], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->free, formatted[2], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->available, formatted[3], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->cached, formatted[4], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->swap_total, formatted[5], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->swap_used, formatted[6], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->buffers, formatted[7], FORMAT_BUFFER_SIZE, opts);
 
     // Calculate percentages
     double mem_used_percent = (double)info->used * 100 / info->total;
@@ -124,8 +242,13 @@ void display_memory_deluxe(MemoryInfo *info, ProgramOptions *opts) {
 
     // Add spinner frame
     offset += snprintf(buffer + offset, sizeof(buffer) - offset,
-                      "%s%s%s\n\n",
+                      "%s%s%s",
                       COLOR_CYAN, SPINNER_FRAMES[frame++ % SPINNER_FRAME_COUNT], COLOR_RESET);
+    if (opts->adaptive_min_ms > 0 && info->interval_ms > 0) {
+        offset += snprintf(buffer + offset, sizeof(buffer) - offset,
+                          " %s%lu ms%s", COLOR_DIM, info->interval_ms, COLOR_RESET);
+    }
+    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "\n\n");
 
     // RAM section
     offset += snprintf(buffer + offset, sizeof(buffer) - offset,
@@ -151,6 +274,19 @@ void display_memory_deluxe(MemoryInfo *info, ProgramOptions *opts) {
                       COLOR_GREEN, ICON_FREE, COLOR_RESET, formatted[2],
                       COLOR_CYAN, ICON_CHART, COLOR_RESET, formatted[3],
                       COLOR_BLUE, ICON_RAM, COLOR_RESET, formatted[7]);
+    if (info->fault_pages > 0) {
+        offset += snprintf(buffer + offset, sizeof(buffer) - offset,
+                          "%s%s Fault%s   p50 %.1f us  p99 %.1f us  max %.1f us\n",
+                          COLOR_MAGENTA, ICON_CHART, COLOR_RESET, info->fault_p50_ns / 1e3,
+                          info->fault_p99_ns / 1e3, info->fault_max_ns / 1e3);
+    }
+    if (info->forecast_samples > 0) {
+        char forecast[FORECAST_BUFFER_SIZE];
+        format_forecast(info->forecast_samples, info->available_eta_s, info->available_eta_low_s,
+                        info->available_eta_high_s, forecast, sizeof(forecast));
+        offset += snprintf(buffer + offset, sizeof(buffer) - offset,
+                          "%s%s ETA%s     %s\n", COLOR_CYAN, ICON_CHART, COLOR_RESET, forecast);
+    }
 
     // Swap section if enabled
     if (info->swap_total > 0) {
@@ -164,6 +300,30 @@ void display_memory_deluxe(MemoryInfo *info, ProgramOptions *opts) {
         // Draw swap usage bar
         draw_memory_bar(swap_used_percent, 30, COLOR_YELLOW);
         printf("\n");
+
+        // One bar per device so disk swap and zram can be told apart
+        for (int i = 0; swap != NULL && i < swap->device_count; i++) {
+            const SwapDevice *dev = &swap->devices[i];
+            const ZramDevice *zram = find_zram_device(swap, dev);
+            double dev_percent = dev->size ? (double)dev->used * 100 / dev->size : 0;
+
+            printf("   %s%-16.16s%s ", COLOR_DIM, dev->name, COLOR_RESET);
+            draw_memory_bar(dev_percent, 20, COLOR_YELLOW);
+            if (zram != NULL) {
+                char cost[FORMAT_BUFFER_SIZE];
+                format_size_timed(zram->mem_used_total, cost, FORMAT_BUFFER_SIZE, opts);
+                printf("  %.2fx, RAM %s",
+                       compression_ratio(zram->orig_data_size, zram->compr_data_size), cost);
+            }
+            printf("\n");
+        }
+
+        if (swap != NULL && swap->zswapped > 0) {
+            char cost[FORMAT_BUFFER_SIZE];
+            format_size_timed(swap->zswap, cost, FORMAT_BUFFER_SIZE, opts);
+            printf("   %s%-16s%s %.2fx, RAM %s\n", COLOR_DIM, "zswap", COLOR_RESET,
+                   compression_ratio(swap->zswapped, swap->zswap), cost);
+        }
     } else {
         // Write accumulated buffer
         printf("%s", buffer);
@@ -172,6 +332,299 @@ void display_memory_deluxe(MemoryInfo *info, ProgramOptions *opts) {
     printf("\n");  // Final newline
 }
 
+static void print_eta_field(const char *name, unsigned long seconds) {
+    if (seconds == FORECAST_NEVER) {
+        printf(" %s=inf", name);
+    } else {
+        printf(" %s=%lu", name, seconds);
+    }
+}
+
+// One sample per line in bytes, for logging and scripts
+void display_memory_line(MemoryInfo *info, ProgramOptions *opts) {
+    (void)opts;
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    printf("time_ms=%lld interval_ms=%lu total=%lu used=%lu free=%lu shared=%lu "
+           "buffers=%lu cached=%lu available=%lu swap_total=%lu swap_used=%lu "
+           "swap_free=%lu",
+           (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000, info->interval_ms,
+           info->total, info->used, info->free, info->shared, info->buffers,
+           info->cached, info->available, info->swap_total, info->swap_used,
+           info->swap_free);
+    if (info->fault_pages > 0) {
+        printf(" fault_p50_ns=%lu fault_p99_ns=%lu fault_max_ns=%lu",
+               info->fault_p50_ns, info->fault_p99_ns, info->fault_max_ns);
+    }
+    if (info->forecast_samples > 0) {
+        print_eta_field("available_eta_s", info->available_eta_s);
+        print_eta_field("available_eta_low_s", info->available_eta_low_s);
+        print_eta_field("available_eta_high_s", info->available_eta_high_s);
+        print_eta_field("swap_free_eta_s", info->swap_free_eta_s);
+        print_eta_field("swap_free_eta_low_s", info->swap_free_eta_low_s);
+        print_eta_field("swap_free_eta_high_s", info->swap_free_eta_high_s);
+    }
+    printf("\n");
+}
+
+// MemTotal split into kernel-reported components and the unaccounted remainder
+void display_breakdown(MemoryInfo *info, ProgramOptions *opts) {
+    MemoryBreakdown breakdown;
+    char size[FORMAT_BUFFER_SIZE], used[FORMAT_BUFFER_SIZE], shared[FORMAT_BUFFER_SIZE],
+         cache[FORMAT_BUFFER_SIZE];
+    double total = info->total ? (double)info->total : 1;
+
+    memory_breakdown(info, &breakdown);
+    format_size_timed(info->used, used, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->shared, shared, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->buffers + info->cached, cache, FORMAT_BUFFER_SIZE, opts);
+
+    if (opts->display_mode == 1) {
+        printf("%s\n%s%s Memory Breakdown%s\n", CLEAR_SCREEN, COLOR_CYAN, ICON_RAM, COLOR_RESET);
+    } else {
+        printf("\nMemory Breakdown:\n"
+               "-----------------\n");
+    }
+    printf("Used: %s  Shared: %s  Buff/cache: %s\n\n", used, shared, cache);
+
+    printf("%-14s %12s %7s\n", "COMPONENT", "SIZE", "%TOTAL");
+    for (int i = 0; i < breakdown.count; i++) {
+        const MemoryPart *part = &breakdown.parts[i];
+        format_size_timed(part->bytes, size, FORMAT_BUFFER_SIZE, opts);
+        printf("%-14s %12s %6.1f%%\n", part->name, size, part->bytes * 100 / total);
+    }
+
+    long unaccounted = breakdown.unaccounted;
+    format_size_timed((unsigned long)(unaccounted < 0 ? -unaccounted : unaccounted),
+                size, FORMAT_BUFFER_SIZE, opts);
+    printf("%-14s %c%11s %6.1f%%\n", "Unaccounted", unaccounted < 0 ? '-' : ' ',
+           size, unaccounted * 100 / total);
+
+    format_size_timed(info->total, size, FORMAT_BUFFER_SIZE, opts);
+    printf("%-14s %12s\n", "MemTotal", size);
+}
+
+// Processes whose RSS has grown steadily over the leak window
+void display_leaks(ProgramOptions *opts) {
+    LeakReport top[LEAK_TOP_COUNT];
+    int count = leaks_top(top, LEAK_TOP_COUNT);
+    char rss[FORMAT_BUFFER_SIZE], rate[FORMAT_BUFFER_SIZE], state[FORMAT_BUFFER_SIZE];
+
+    if (opts->display_mode == 1) {
+        printf("%s\n%s%s Leak Watch%s\n", CLEAR_SCREEN, COLOR_CYAN, ICON_CHART, COLOR_RESET);
+    } else {
+        printf("\nGrowing Processes:\n"
+               "------------------\n");
+    }
+
+    format_size_timed(leaks_state_bytes(), state, FORMAT_BUFFER_SIZE, opts);
+    printf("Tracking %d processes (%s of trend state)\n\n", leaks_tracked(), state);
+
+    if (count == 0) {
+        printf("No steadily growing processes\n");
+        return;
+    }
+
+    printf("%-8s %-16s %12s %14s %6s %9s\n", "PID", "COMMAND", "RSS", "GROWTH/MIN", "MONO", "WATCHED");
+    for (int i = 0; i < count; i++) {
+        format_size_timed(top[i].rss, rss, FORMAT_BUFFER_SIZE, opts);
+        format_size_timed((unsigned long)(top[i].slope * 60), rate, FORMAT_BUFFER_SIZE, opts);
+        printf("%-8d %-16s %12s %14s %5.0f%% %8.0fs\n",
+               (int)top[i].pid, top[i].comm, rss, rate,
+               top[i].monotonic * 100, top[i].tracked_s);
+    }
+}
+
+// Kernel slab usage, largest caches first
+void display_slab(MemoryInfo *info, ProgramOptions *opts) {
+    SlabCache top[SLAB_TOP_COUNT];
+    int count = slab_top(top, SLAB_TOP_COUNT);
+    char size[FORMAT_BUFFER_SIZE], reclaim[FORMAT_BUFFER_SIZE],
+         unreclaim[FORMAT_BUFFER_SIZE], growth[FORMAT_BUFFER_SIZE];
+
+    format_size_timed(slab_total_bytes(), size, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->slab_reclaimable, reclaim, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(info->slab_unreclaimable, unreclaim, FORMAT_BUFFER_SIZE, opts);
+
+    if (opts->display_mode == 1) {
+        printf("%s\n%s%s Slab Caches%s\n", CLEAR_SCREEN, COLOR_CYAN, ICON_CACHE, COLOR_RESET);
+    } else {
+        printf("\nSlab Caches:\n"
+               "------------\n");
+    }
+    printf("Reclaimable:   %s\n"
+           "Unreclaimable: %s\n"
+           "Total:         %s in %d caches\n\n",
+           reclaim, unreclaim, size, slab_cache_count());
+
+    printf("%-24s %12s %21s %8s %13s\n", "CACHE", "SIZE", "OBJECTS (ACTIVE)", "OBJSIZE", "GROWTH/S");
+    for (int i = 0; i < count; i++) {
+        const SlabCache *cache = &top[i];
+        format_size_timed(cache->bytes, size, FORMAT_BUFFER_SIZE, opts);
+        format_size_timed((unsigned long)(cache->growth < 0 ? -cache->growth : cache->growth),
+                    growth, FORMAT_BUFFER_SIZE, opts);
+        printf("%-24.24s %12s %10lu (%8lu) %8lu %c%12s\n",
+               cache->name, size, cache->num_objs, cache->active_objs, cache->objsize,
+               cache->growth < 0 ? '-' : '+', growth);
+    }
+}
+
+static void print_fincore_entries(const FincoreEntry *entries, int count, ProgramOptions *opts) {
+    char cached[FORMAT_BUFFER_SIZE], size[FORMAT_BUFFER_SIZE];
+
+    for (int i = 0; i < count; i++) {
+        const FincoreEntry *e = &entries[i];
+        format_size_timed(e->cached, cached, FORMAT_BUFFER_SIZE, opts);
+        format_size_timed(e->size, size, FORMAT_BUFFER_SIZE, opts);
+        printf("%12s %12s %5.1f%%  %s\n", cached, size,
+               e->size ? (double)e->cached * 100 / e->size : 0, e->path);
+    }
+}
+
+// Page cache residency of the scanned files, ranked by cached bytes
+void display_fincore(const FincoreReport *report, ProgramOptions *opts) {
+    char cached[FORMAT_BUFFER_SIZE], size[FORMAT_BUFFER_SIZE];
+
+    format_size_timed(report->total_cached, cached, FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(report->total_size, size, FORMAT_BUFFER_SIZE, opts);
+
+    if (opts->display_mode == 1) {
+        printf("%s\n%s%s Page Cache Residency%s\n", CLEAR_SCREEN, COLOR_CYAN, ICON_CACHE, COLOR_RESET);
+    } else {
+        printf("\nPage Cache Residency:\n"
+               "---------------------\n");
+    }
+    printf("%s of %s cached (%.1f%%) in %lu files, %lu directories, scanned in %.2f s\n",
+           cached, size,
+           report->total_size ? (double)report->total_cached * 100 / report->total_size : 0,
+           report->files, report->dirs, report->elapsed_s);
+    if (report->errors > 0) {
+        printf("%lu entries could not be read\n", report->errors);
+    }
+    if (report->unknown > 0) {
+        printf("%lu files skipped: residency is only visible to their owner or writers\n",
+               report->unknown);
+    }
+
+    if (report->top_file_count > 0) {
+        printf("\n%12s %12s %6s  %s\n", "CACHED", "SIZE", "PCT", "FILE");
+        print_fincore_entries(report->top_files, report->top_file_count, opts);
+    }
+    if (report->top_dir_count > 0) {
+        printf("\n%12s %12s %6s  %s\n", "CACHED", "SIZE", "PCT", "DIRECTORY");
+        print_fincore_entries(report->top_dirs, report->top_dir_count, opts);
+    }
+}
+
+static void print_smaps_row(const SmapsMapping *m, ProgramOptions *opts) {
+    char values[5][FORMAT_BUFFER_SIZE];
+    format_size_timed(m->rss, values[0], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(m->pss, values[1], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(m->private_dirty, values[2], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(m->swap, values[3], FORMAT_BUFFER_SIZE, opts);
+    format_size_timed(m->anon_huge, values[4], FORMAT_BUFFER_SIZE, opts);
+
+    printf("%11s %11s %11s %11s %11s %6lu  %s\n",
+           values[0], values[1], values[2], values[3], values[4], m->vmas, m->name);
+}
+
+// Per-mapping memory of one process, largest resident first
+void display_smaps(const SmapsSummary *summary, ProgramOptions *opts) {
+    SmapsMapping top[SMAPS_TOP_COUNT];
+    int count = smaps_top(top, SMAPS_TOP_COUNT);
+
+    if (opts->display_mode == 1) {
+        printf("%s\n%s%s Process %d (%s)%s\n", CLEAR_SCREEN, COLOR_CYAN, ICON_RAM,
+               (int)summary->pid, summary->comm, COLOR_RESET);
+    } else {
+        printf("\nProcess %d (%s) Mappings:\n"
+               "-------------------------\n", (int)summary->pid, summary->comm);
+    }
+    printf("%lu VMAs in %d distinct mappings, %lu bytes of smaps parsed in %.3f s\n\n",
+           summary->total.vmas, summary->mapping_count, summary->bytes_parsed,
+           summary->elapsed_s);
+
+    printf("%11s %11s %11s %11s %11s %6s  %s\n",
+           "RSS", "PSS", "PRIV_DIRTY", "SWAP", "ANON_HUGE", "VMAS", "MAPPING");
+    for (int i = 0; i < count; i++) {
+        print_smaps_row(&top[i], opts);
+    }
+    print_smaps_row(&summary->total, opts);
+}
+
+// Signed distance of free pages above (+) or below (-) a watermark
+static void format_watermark_distance(const ZoneStats *zone, unsigned long mark,
+                                      unsigned long page_size, char *out, ProgramOptions *opts) {
+    char size[FORMAT_BUFFER_SIZE - 1];     // leaves room for the sign
+    unsigned long pages = zone->free >= mark ? zone->free - mark : mark - zone->free;
+
+    format_size_timed(pages * page_size, size, sizeof(size), opts);
+    snprintf(out, FORMAT_BUFFER_SIZE, "%c%s", zone->free >= mark ? '+' : '-', size);
+}
+
+static const char *zone_state(const ZoneStats *zone) {
+    if (zone->free <= zone->min) return "below min: direct reclaim";
+    if (zone->free <= zone->low) return "below low: kswapd";
+    if (zone->free <= zone->high) return "below high";
+    return "ok";
+}
+
+// Per-zone distance to the watermarks and buddy allocator fragmentation
+void display_zones(const ZoneReport *report, ProgramOptions *opts) {
+    char managed[FORMAT_BUFFER_SIZE], free[FORMAT_BUFFER_SIZE], marks[3][FORMAT_BUFFER_SIZE];
+    char zone_name[ZONE_NAME_MAX + 16];
+    int max_orders = 0;
+
+    if (opts->display_mode == 1) {
+        printf("%s\n%s%s Zone Watermarks%s\n", CLEAR_SCREEN, COLOR_CYAN, ICON_RAM, COLOR_RESET);
+    } else {
+        printf("\nZone Watermarks:\n"
+               "----------------\n");
+    }
+    printf("%d zones, %lu bytes of zoneinfo and buddyinfo parsed in %.3f s\n\n",
+           report->count, report->bytes_parsed, report->elapsed_s);
+
+    printf("%-14s %11s %11s %12s %12s %12s  %s\n",
+           "NODE/ZONE", "MANAGED", "FREE", "TO MIN", "TO LOW", "TO HIGH", "STATE");
+    for (int i = 0; i < report->count; i++) {
+        const ZoneStats *zone = &report->zones[i];
+        format_size_timed(zone->managed * report->page_size, managed, FORMAT_BUFFER_SIZE, opts);
+        format_size_timed(zone->free * report->page_size, free, FORMAT_BUFFER_SIZE, opts);
+        format_watermark_distance(zone, zone->min, report->page_size, marks[0], opts);
+        format_watermark_distance(zone, zone->low, report->page_size, marks[1], opts);
+        format_watermark_distance(zone, zone->high, report->page_size, marks[2], opts);
+        snprintf(zone_name, sizeof(zone_name), "%d/%s", zone->node, zone->name);
+
+        printf("%-14s %11s %11s %12s %12s %12s  %s\n", zone_name, managed, free,
+               marks[0], marks[1], marks[2], zone_state(zone));
+        if (zone->orders > max_orders) max_orders = zone->orders;
+    }
+
+    // Free blocks per order, and the unusable free space index: the share of
+    // free memory in blocks too small for an allocation of that order
+    printf("\n%-14s %8s", "FREE BLOCKS", "ORDER");
+    for (int order = 0; order < max_orders; order++) {
+        printf(" %6d", order);
+    }
+    printf("\n");
+    for (int i = 0; i < report->count; i++) {
+        const ZoneStats *zone = &report->zones[i];
+        if (zone->orders == 0) continue;
+
+        snprintf(zone_name, sizeof(zone_name), "%d/%s", zone->node, zone->name);
+        printf("%-14s %8s", zone_name, "blocks");
+        for (int order = 0; order < zone->orders; order++) {
+            printf(" %6lu", zone->blocks[order]);
+        }
+        printf("\n%-14s %8s", "", "unusable");
+        for (int order = 0; order < zone->orders; order++) {
+            printf(" %6.2f", zone->unusable[order]);
+        }
+        printf("\n");
+    }
+}
+
 void show_loading_animation(void) {
     static const char* frames[] = {
         "⠋ Installing", "⠙ Installing", "⠹ Installing",
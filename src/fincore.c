@@ -0,0 +1,479 @@
+// src/fincore.c
+#define _GNU_SOURCE     // For O_NOATIME, SEEK_DATA and SEEK_HOLE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "../include/fincore.h"
+#include "../include/utils.h"
+
+#define FINCORE_WINDOW (1UL << 30)  // bytes mapped per mincore() call
+#define INITIAL_QUEUE_CAPACITY 64
+
+#ifndef __NR_cachestat
+#define __NR_cachestat 451          // Linux 6.5, same number on every architecture
+#endif
+
+// cachestat(2) arguments, from <linux/mman.h> on new enough headers
+typedef struct {
+    uint64_t off;
+    uint64_t len;                   // 0: to the end of the file
+} CachestatRange;
+
+typedef struct {
+    uint64_t nr_cache;
+    uint64_t nr_dirty;
+    uint64_t nr_writeback;
+    uint64_t nr_evicted;
+    uint64_t nr_recently_evicted;
+} Cachestat;
+
+// A directory being walked.  Once its own files are measured, their totals
+// are added to it and every ancestor, so each node ends up with its subtree.
+typedef struct DirNode {
+    struct DirNode *parent;
+    struct DirNode *next;           // the worker's list of walked directories
+    unsigned long size;             // updated atomically by any worker
+    unsigned long cached;
+    char path[];
+} DirNode;
+
+// Per-thread state; merged into the report once the walk is done
+typedef struct {
+    pthread_t thread;
+    unsigned char *vec;             // mincore() result for one window
+    FincoreEntry top_files[FINCORE_TOP_COUNT];
+    int top_file_count;
+    DirNode *dirs_walked;
+    unsigned long files;
+    unsigned long dirs;
+    unsigned long errors;
+    unsigned long unknown;
+    unsigned long total_size;
+    unsigned long total_cached;
+} FincoreWorker;
+
+// Directories waiting to be walked, shared by all workers (LIFO keeps it shallow)
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    DirNode **nodes;
+    int count;
+    int capacity;
+    int busy;               // directories being processed right now
+} WorkQueue;
+
+static WorkQueue queue = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+};
+static FincoreReport report;
+static long page_size;
+static bool cachestat_missing;      // kernel predates cachestat(2)
+
+static bool queue_push(DirNode *node) {
+    pthread_mutex_lock(&queue.lock);
+    if (queue.count == queue.capacity) {
+        int capacity = queue.capacity ? queue.capacity * 2 : INITIAL_QUEUE_CAPACITY;
+        DirNode **nodes = realloc(queue.nodes, capacity * sizeof(DirNode *));
+        if (nodes == NULL) {
+            pthread_mutex_unlock(&queue.lock);
+            return false;
+        }
+        queue.nodes = nodes;
+        queue.capacity = capacity;
+    }
+    queue.nodes[queue.count++] = node;
+    pthread_cond_signal(&queue.cond);
+    pthread_mutex_unlock(&queue.lock);
+    return true;
+}
+
+// Take the next directory, or NULL once the queue is empty and nobody can add more
+static DirNode *queue_pop(void) {
+    pthread_mutex_lock(&queue.lock);
+    while (queue.count == 0 && queue.busy > 0) {
+        pthread_cond_wait(&queue.cond, &queue.lock);
+    }
+
+    DirNode *node = NULL;
+    if (queue.count > 0) {
+        node = queue.nodes[--queue.count];
+        queue.busy++;
+    }
+    pthread_mutex_unlock(&queue.lock);
+    return node;
+}
+
+// Queue a directory below parent (NULL for a command line argument)
+static bool queue_dir(DirNode *parent, const char *path) {
+    size_t len = strlen(path) + 1;
+    DirNode *node = malloc(sizeof(DirNode) + len);
+    if (node == NULL) {
+        return false;
+    }
+    node->parent = parent;
+    node->next = NULL;
+    node->size = 0;
+    node->cached = 0;
+    memcpy(node->path, path, len);
+
+    if (!queue_push(node)) {
+        free(node);
+        return false;
+    }
+    return true;
+}
+
+static void queue_done(void) {
+    pthread_mutex_lock(&queue.lock);
+    if (--queue.busy == 0 && queue.count == 0) {
+        pthread_cond_broadcast(&queue.cond);
+    }
+    pthread_mutex_unlock(&queue.lock);
+}
+
+// Keep the FINCORE_TOP_COUNT entries with the most cached bytes, largest first
+static void rank_entry(FincoreEntry *top, int *count, const char *path,
+                       unsigned long size, unsigned long cached) {
+    if (*count == FINCORE_TOP_COUNT && top[FINCORE_TOP_COUNT - 1].cached >= cached) {
+        return;
+    }
+
+    int pos = *count < FINCORE_TOP_COUNT ? (*count)++ : FINCORE_TOP_COUNT - 1;
+    while (pos > 0 && top[pos - 1].cached < cached) {
+        top[pos] = top[pos - 1];
+        pos--;
+    }
+
+    snprintf(top[pos].path, sizeof(top[pos].path), "%s", path);
+    top[pos].size = size;
+    top[pos].cached = cached;
+}
+
+// Count resident pages in the vec filled by mincore(); only bit 0 is defined
+static unsigned long count_resident(const unsigned char *vec, size_t pages) {
+    unsigned long resident = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= pages; i += 8) {
+        uint64_t word;
+        memcpy(&word, vec + i, sizeof(word));
+        resident += __builtin_popcountll(word & 0x0101010101010101ULL);
+    }
+    for (; i < pages; i++) {
+        resident += vec[i] & 1;
+    }
+    return resident;
+}
+
+// Resident bytes of [start, end) using PROT_NONE windows so no page is ever faulted in
+static unsigned long scan_range(FincoreWorker *w, int fd, off_t start, off_t end) {
+    unsigned long resident = 0;
+
+    start &= ~(off_t)(page_size - 1);
+    for (off_t off = start; off < end; off += FINCORE_WINDOW) {
+        size_t len = (end - off) < (off_t)FINCORE_WINDOW ? (size_t)(end - off) : FINCORE_WINDOW;
+        void *map = mmap(NULL, len, PROT_NONE, MAP_SHARED, fd, off);
+        if (map == MAP_FAILED) {
+            w->errors++;
+            return resident;
+        }
+
+        size_t pages = (len + page_size - 1) / page_size;
+        if (mincore(map, len, w->vec) == 0) {
+            resident += count_resident(w->vec, pages) * page_size;
+        } else {
+            w->errors++;
+        }
+        munmap(map, len);
+    }
+
+    return resident;
+}
+
+// Only data extents can be cached; holes in sparse files are skipped
+static unsigned long scan_file(FincoreWorker *w, int fd, off_t size) {
+    unsigned long resident = 0;
+    off_t pos = 0;
+
+    while (pos < size) {
+        off_t data = lseek(fd, pos, SEEK_DATA);
+        if (data < 0) {
+            if (errno == ENXIO) break;          // only a hole remains
+            return resident + scan_range(w, fd, pos, size);   // no SEEK_DATA support
+        }
+
+        off_t hole = lseek(fd, data, SEEK_HOLE);
+        if (hole < 0 || hole > size) hole = size;
+
+        resident += scan_range(w, fd, data, hole);
+        pos = hole;
+    }
+
+    return resident > (unsigned long)size ? (unsigned long)size : resident;
+}
+
+// Since Linux 5.0, mincore() on a file mapping reports real residency only
+// to the owner, a writer or CAP_FOWNER; anyone else silently sees nothing
+static bool may_mincore(const char *path, const struct stat *st) {
+    uid_t euid = geteuid();
+    return euid == 0 || st->st_uid == euid || faccessat(AT_FDCWD, path, W_OK, AT_EACCESS) == 0;
+}
+
+// Cached bytes of a whole file; false when the kernel will not tell us
+static bool file_residency(FincoreWorker *w, int fd, const char *path, const struct stat *st,
+                           unsigned long *cached) {
+    if (!__atomic_load_n(&cachestat_missing, __ATOMIC_RELAXED)) {
+        CachestatRange range = {0, 0};
+        Cachestat cs;
+        if (syscall(__NR_cachestat, fd, &range, &cs, 0) == 0) {
+            unsigned long bytes = (unsigned long)cs.nr_cache * page_size;
+            *cached = bytes > (unsigned long)st->st_size ? (unsigned long)st->st_size : bytes;
+            return true;
+        }
+        if (errno == EPERM) {
+            return false;       // same ownership rule as mincore() on newer kernels
+        }
+        if (errno == ENOSYS) {
+            __atomic_store_n(&cachestat_missing, true, __ATOMIC_RELAXED);
+        }
+    }
+
+    if (!may_mincore(path, st)) {
+        return false;
+    }
+    *cached = scan_file(w, fd, st->st_size);
+    return true;
+}
+
+static void account_file(FincoreWorker *w, int fd, const char *path, const struct stat *st,
+                         unsigned long *dir_size, unsigned long *dir_cached) {
+    unsigned long cached = 0;
+    if (st->st_size > 0 && !file_residency(w, fd, path, st, &cached)) {
+        w->unknown++;   // reported separately, never as 0 cached
+        return;
+    }
+
+    w->files++;
+    w->total_size += st->st_size;
+    w->total_cached += cached;
+    *dir_size += st->st_size;
+    *dir_cached += cached;
+
+    if (cached > 0) {
+        rank_entry(w->top_files, &w->top_file_count, path, st->st_size, cached);
+    }
+}
+
+// Walk one directory: files are measured through openat() on the directory
+// fd, subdirectories are queued for any worker
+static void scan_directory(FincoreWorker *w, DirNode *node) {
+    const char *path = node->path;
+    int dfd = open(path, O_RDONLY | O_DIRECTORY | O_NOATIME);
+    if (dfd < 0) {
+        dfd = open(path, O_RDONLY | O_DIRECTORY);   // O_NOATIME needs ownership
+    }
+    DIR *dir = dfd >= 0 ? fdopendir(dfd) : NULL;
+    if (dir == NULL) {
+        if (dfd >= 0) close(dfd);
+        w->errors++;
+        return;
+    }
+
+    char child[PATH_MAX];
+    unsigned long dir_size = 0, dir_cached = 0;
+    struct dirent *entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        const char *name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        // Only regular files can be cached; opening devices or FIFOs may have side effects
+        if (entry->d_type != DT_REG && entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN) {
+            continue;
+        }
+
+        if (snprintf(child, sizeof(child), "%s/%s", path, name) >= (int)sizeof(child)) {
+            w->errors++;
+            continue;
+        }
+
+        if (entry->d_type == DT_DIR) {
+            if (!queue_dir(node, child)) {
+                w->errors++;
+            }
+            continue;
+        }
+
+        int fd = openat(dfd, name, O_RDONLY | O_NOFOLLOW | O_NOATIME | O_NONBLOCK);
+        if (fd < 0) {
+            fd = openat(dfd, name, O_RDONLY | O_NOFOLLOW | O_NONBLOCK);
+        }
+        if (fd < 0) {
+            if (errno != ELOOP) w->errors++;
+            continue;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            if (S_ISREG(st.st_mode)) {
+                account_file(w, fd, child, &st, &dir_size, &dir_cached);
+            } else if (S_ISDIR(st.st_mode)) {
+                // Filesystems that do not fill in d_type
+                if (!queue_dir(node, child)) {
+                    w->errors++;
+                }
+            }
+        } else {
+            w->errors++;
+        }
+        close(fd);
+    }
+
+    closedir(dir);
+    w->dirs++;
+
+    // Directories are ranked by their whole subtree once the walk is done
+    for (DirNode *d = node; d != NULL; d = d->parent) {
+        __atomic_fetch_add(&d->size, dir_size, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&d->cached, dir_cached, __ATOMIC_RELAXED);
+    }
+}
+
+static void *worker_main(void *arg) {
+    FincoreWorker *w = arg;
+    DirNode *node;
+
+    // Nodes stay allocated until the report is built; descendants point at them
+    while ((node = queue_pop()) != NULL) {
+        scan_directory(w, node);
+        node->next = w->dirs_walked;
+        w->dirs_walked = node;
+        queue_done();
+    }
+    return NULL;
+}
+
+static void scan_argument(FincoreWorker *w, const char *path) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "Error: Cannot access %s: %s\n", path, strerror(errno));
+        w->errors++;
+        return;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        if (!queue_dir(NULL, path)) {
+            w->errors++;
+        }
+        return;
+    }
+
+    int fd = open(path, O_RDONLY | O_NOATIME);
+    if (fd < 0) {
+        fd = open(path, O_RDONLY);
+    }
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open %s: %s\n", path, strerror(errno));
+        w->errors++;
+        return;
+    }
+
+    unsigned long dir_size = 0, dir_cached = 0;
+    if (S_ISREG(st.st_mode)) {
+        account_file(w, fd, path, &st, &dir_size, &dir_cached);
+    }
+    close(fd);
+}
+
+static void merge_worker(FincoreWorker *w) {
+    for (int i = 0; i < w->top_file_count; i++) {
+        const FincoreEntry *e = &w->top_files[i];
+        rank_entry(report.top_files, &report.top_file_count, e->path, e->size, e->cached);
+    }
+    while (w->dirs_walked != NULL) {
+        DirNode *d = w->dirs_walked;
+        w->dirs_walked = d->next;
+        if (d->cached > 0) {
+            rank_entry(report.top_dirs, &report.top_dir_count, d->path, d->size, d->cached);
+        }
+        free(d);
+    }
+    report.files += w->files;
+    report.dirs += w->dirs;
+    report.errors += w->errors;
+    report.unknown += w->unknown;
+    report.total_size += w->total_size;
+    report.total_cached += w->total_cached;
+}
+
+// Public function to scan paths with one worker per CPU (capped)
+const FincoreReport *fincore_scan(char *const *paths, int count) {
+    uint64_t start_ns = monotonic_ns();
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus < 1 ? 1 : (cpus > FINCORE_MAX_THREADS ? FINCORE_MAX_THREADS : (int)cpus);
+
+    page_size = sysconf(_SC_PAGESIZE);
+    memset(&report, 0, sizeof(report));
+
+    FincoreWorker *workers = calloc(threads, sizeof(FincoreWorker));
+    if (workers == NULL) {
+        fprintf(stderr, "Error: Failed to allocate fincore workers\n");
+        return NULL;
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i].vec = malloc(FINCORE_WINDOW / page_size);
+        if (workers[i].vec == NULL) {
+            threads = i;
+            break;
+        }
+    }
+    if (threads == 0) {
+        free(workers);
+        return NULL;
+    }
+
+    __atomic_store_n(&cachestat_missing, false, __ATOMIC_RELAXED);
+
+    // Plain files are measured here; directories seed the shared queue
+    for (int i = 0; i < count; i++) {
+        scan_argument(&workers[0], paths[i]);
+    }
+
+    int started = 0;
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    if (started == 0) {
+        worker_main(&workers[0]);   // no threads available, walk inline
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    // Subtree totals are final only now; every node is in some worker's list
+    for (int i = 0; i < threads; i++) {
+        merge_worker(&workers[i]);
+        free(workers[i].vec);
+    }
+    free(workers);
+    free(queue.nodes);
+    queue.nodes = NULL;
+    queue.capacity = 0;
+
+    report.elapsed_s = (double)(monotonic_ns() - start_ns) / 1e9;
+    return &report;
+}
@@ -0,0 +1,84 @@
+// src/forecast.c
+#include <string.h>
+#include <math.h>
+#include "../include/forecast.h"
+
+void forecast_init(Forecaster *forecaster) {
+    memset(forecaster, 0, sizeof(*forecaster));
+}
+
+// O(1) update with the interval-aware Holt recurrences
+static void holt_update(HoltSeries *s, double value, uint64_t now_ns) {
+    if (s->samples == 0 || now_ns <= s->last_ns) {
+        if (s->samples == 0) {
+            s->level = value;
+        }
+        s->last_ns = now_ns;
+        s->samples++;
+        return;
+    }
+
+    double dt = (double)(now_ns - s->last_ns) / 1e9;
+    double predicted = s->level + s->trend * dt;
+    double residual = value - predicted;
+    double prev_level = s->level;
+
+    s->level = FORECAST_ALPHA * value + (1 - FORECAST_ALPHA) * predicted;
+    double slope = (s->level - prev_level) / dt;
+
+    // Seed the trend from the first difference instead of decaying up from 0
+    if (s->samples == 1) {
+        s->trend = slope;
+    } else {
+        double slope_residual = slope - s->trend;
+        s->slope_var = FORECAST_BETA * slope_residual * slope_residual +
+                       (1 - FORECAST_BETA) * s->slope_var;
+        s->trend = FORECAST_BETA * slope + (1 - FORECAST_BETA) * s->trend;
+    }
+    s->level_var = FORECAST_ALPHA * residual * residual + (1 - FORECAST_ALPHA) * s->level_var;
+
+    s->last_ns = now_ns;
+    s->samples++;
+}
+
+static unsigned long eta_seconds(double remaining, double rate) {
+    if (rate <= 0) {
+        return FORECAST_NEVER;
+    }
+    double eta = (remaining > 0 ? remaining : 0) / rate;
+    return eta >= (double)FORECAST_NEVER ? FORECAST_NEVER : (unsigned long)eta;
+}
+
+// Seconds until the smoothed level reaches zero, with bounds from the level
+// noise and from the spread of the trend (an EWMA of slopes with weight beta
+// has beta / (2 - beta) of their variance)
+static void holt_eta(const HoltSeries *s, unsigned long *eta, unsigned long *low, unsigned long *high) {
+    *eta = *low = *high = FORECAST_NEVER;
+    if (s->samples < FORECAST_MIN_SAMPLES) {
+        return;
+    }
+
+    double level_sd = sqrt(s->level_var);
+    double trend_sd = sqrt(s->slope_var * FORECAST_BETA / (2 - FORECAST_BETA));
+    double rate = -s->trend;
+
+    *eta = eta_seconds(s->level, rate);
+    *low = eta_seconds(s->level - FORECAST_Z * level_sd, rate + FORECAST_Z * trend_sd);
+    *high = eta_seconds(s->level + FORECAST_Z * level_sd, rate - FORECAST_Z * trend_sd);
+}
+
+// Feed one sample and store both ETAs in info
+void forecast_update(Forecaster *forecaster, MemoryInfo *info, uint64_t now_ns) {
+    holt_update(&forecaster->available, (double)info->available, now_ns);
+    holt_eta(&forecaster->available, &info->available_eta_s,
+             &info->available_eta_low_s, &info->available_eta_high_s);
+
+    if (info->swap_total > 0) {
+        holt_update(&forecaster->swap_free, (double)info->swap_free, now_ns);
+        holt_eta(&forecaster->swap_free, &info->swap_free_eta_s,
+                 &info->swap_free_eta_low_s, &info->swap_free_eta_high_s);
+    } else {
+        info->swap_free_eta_s = info->swap_free_eta_low_s = info->swap_free_eta_high_s = FORECAST_NEVER;
+    }
+    info->forecast_samples = forecaster->available.samples;
+}
@@ -0,0 +1,413 @@
+// src/leaks.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <math.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/leaks.h"
+#include "../include/procio.h"
+
+#define PROC_PATH "/proc"
+#define STAT_BUFFER_SIZE 512
+#define STAT_STARTTIME_FIELD 22
+#define STAT_RSS_FIELD 24
+#define EVICT_CANDIDATES 8                  // entries sampled per eviction
+#define MIN_LEAK_SAMPLES 10
+#define MIN_WINDOW_SPAN 0.1                 // observed share of the window before ranking
+#define MIN_MONOTONIC 0.9
+#define MIN_WINDOW_GROWTH (1024UL * 1024)   // ignore trends worth less than 1 MiB per window
+#define NO_ENTRY -1
+
+/*
+ * Per-process trend state.  RSS is fitted against time with an
+ * exponentially weighted least-squares regression, so each entry is a
+ * fixed handful of running sums no matter how long the process lives.
+ * Time is measured from an origin that follows the weighted mean of the
+ * samples, so the sums stay small however long the run.
+ */
+typedef struct {
+    pid_t pid;
+    unsigned long long starttime;   // with pid, identifies one process across PID reuse
+    int hash_next;          // chain within a hash bucket
+    int lru_prev;           // towards most recently seen
+    int lru_next;           // towards least recently seen
+    uint32_t generation;    // scan that last saw this process
+    unsigned long last_rss;
+    double t0;              // first sample time, seconds since leaks_init
+    double last_t;
+    double origin;          // time the regression sums are relative to
+    double sw, st, sx, stt, stx;    // weighted regression sums
+    double up, n;           // weighted count of non-shrinking samples, of samples
+    uint32_t samples;
+} LeakEntry;
+
+typedef struct {
+    LeakEntry *entries;
+    int *buckets;
+    int bucket_mask;
+    int cap;
+    int used;
+    int free_head;          // free list threaded through hash_next
+    int lru_head;
+    int lru_tail;
+    uint32_t generation;
+    uint32_t rng;           // xorshift state for picking eviction candidates
+    uint64_t start_ns;
+    double window_s;
+    long page_size;
+} LeakTracker;
+
+static LeakTracker tracker;
+
+static inline int bucket_of(pid_t pid) {
+    return (int)(((uint32_t)pid * 2654435761U) & (uint32_t)tracker.bucket_mask);
+}
+
+static void lru_unlink(int idx) {
+    LeakEntry *e = &tracker.entries[idx];
+    if (e->lru_prev != NO_ENTRY) tracker.entries[e->lru_prev].lru_next = e->lru_next;
+    else tracker.lru_head = e->lru_next;
+    if (e->lru_next != NO_ENTRY) tracker.entries[e->lru_next].lru_prev = e->lru_prev;
+    else tracker.lru_tail = e->lru_prev;
+}
+
+static void lru_push_front(int idx) {
+    LeakEntry *e = &tracker.entries[idx];
+    e->lru_prev = NO_ENTRY;
+    e->lru_next = tracker.lru_head;
+    if (tracker.lru_head != NO_ENTRY) tracker.entries[tracker.lru_head].lru_prev = idx;
+    tracker.lru_head = idx;
+    if (tracker.lru_tail == NO_ENTRY) tracker.lru_tail = idx;
+}
+
+static void remove_entry(int idx) {
+    LeakEntry *e = &tracker.entries[idx];
+    int *link = &tracker.buckets[bucket_of(e->pid)];
+
+    while (*link != idx) {
+        link = &tracker.entries[*link].hash_next;
+    }
+    *link = e->hash_next;
+
+    lru_unlink(idx);
+    e->hash_next = tracker.free_head;
+    tracker.free_head = idx;
+    tracker.used--;
+}
+
+static int find_entry(pid_t pid) {
+    for (int idx = tracker.buckets[bucket_of(pid)]; idx != NO_ENTRY;
+         idx = tracker.entries[idx].hash_next) {
+        if (tracker.entries[idx].pid == pid) {
+            return idx;
+        }
+    }
+    return NO_ENTRY;
+}
+
+static void read_comm(pid_t pid, char *comm, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), PROC_PATH "/%d/comm", (int)pid);
+
+    int fd = open(path, O_RDONLY);
+    ssize_t len = fd >= 0 ? read(fd, comm, size - 1) : -1;
+    if (fd >= 0) {
+        procio_count(len > 0 ? (size_t)len : 0);
+        close(fd);
+    }
+
+    if (len <= 0) {
+        snprintf(comm, size, "?");
+        return;
+    }
+    comm[len] = '\0';
+    comm[strcspn(comm, "\n")] = '\0';
+}
+
+static double entry_slope(const LeakEntry *e) {
+    double denom = e->sw * e->stt - e->st * e->st;
+    return denom > 1e-9 ? (e->sw * e->stx - e->st * e->sx) / denom : 0.0;
+}
+
+// How strongly an entry looks like a leak; entries still warming up are neutral
+static double leak_strength(const LeakEntry *e) {
+    if (e->samples < MIN_LEAK_SAMPLES || e->n <= 0) {
+        return 0.0;
+    }
+    return entry_slope(e) * e->up / e->n;
+}
+
+// Pick the weakest of a few random entries.  Sampling keeps eviction O(1)
+// while steady growers, which score highest, almost always survive.
+static int eviction_victim(void) {
+    int victim = NO_ENTRY;
+    double weakest = 0.0;
+
+    for (int i = 0; i < EVICT_CANDIDATES; i++) {
+        tracker.rng ^= tracker.rng << 13;
+        tracker.rng ^= tracker.rng >> 17;
+        tracker.rng ^= tracker.rng << 5;
+
+        // Eviction only happens when every slot is in use
+        int idx = (int)(tracker.rng % (uint32_t)tracker.cap);
+        const LeakEntry *e = &tracker.entries[idx];
+        double strength = leak_strength(e);
+        if (victim == NO_ENTRY || strength < weakest ||
+            (strength == weakest && e->samples < tracker.entries[victim].samples)) {
+            victim = idx;
+            weakest = strength;
+        }
+    }
+    return victim;
+}
+
+static int insert_entry(pid_t pid, unsigned long long starttime) {
+    // At --leak-cap, make room by dropping the entry least likely to be a leak
+    if (tracker.free_head == NO_ENTRY) {
+        remove_entry(eviction_victim());
+    }
+
+    int idx = tracker.free_head;
+    LeakEntry *e = &tracker.entries[idx];
+    tracker.free_head = e->hash_next;
+
+    memset(e, 0, sizeof(*e));
+    e->pid = pid;
+    e->starttime = starttime;
+    int bucket = bucket_of(pid);
+    e->hash_next = tracker.buckets[bucket];
+    tracker.buckets[bucket] = idx;
+    lru_push_front(idx);
+    tracker.used++;
+    return idx;
+}
+
+// Start time and resident bytes from /proc/[pid]/stat.  The command name
+// may contain spaces and parentheses, so fields are counted from its last ')'.
+static bool read_stat(pid_t pid, unsigned long long *starttime, unsigned long *rss) {
+    char path[64], buf[STAT_BUFFER_SIZE];
+    snprintf(path, sizeof(path), PROC_PATH "/%d/stat", (int)pid);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;   // process exited mid-scan
+    }
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    procio_count(len > 0 ? (size_t)len : 0);
+    close(fd);
+    if (len <= 0) {
+        return false;
+    }
+    buf[len] = '\0';
+
+    char *p = strrchr(buf, ')');
+    if (p == NULL) {
+        return false;
+    }
+
+    // p + 1 starts field 3 (state)
+    unsigned long pages = 0;
+    bool have_start = false;
+    int field = 2;
+    while (field < STAT_RSS_FIELD && (p = strchr(p + 1, ' ')) != NULL) {
+        field++;
+        if (field == STAT_STARTTIME_FIELD) {
+            *starttime = strtoull(p + 1, NULL, 10);
+            have_start = true;
+        } else if (field == STAT_RSS_FIELD) {
+            pages = strtoul(p + 1, NULL, 10);
+        }
+    }
+    if (!have_start || field < STAT_RSS_FIELD) {
+        return false;
+    }
+    *rss = pages * (unsigned long)tracker.page_size;
+    return true;
+}
+
+static void update_entry(LeakEntry *e, unsigned long rss, double t) {
+    if (e->samples == 0) {
+        e->t0 = t;
+        e->origin = t;
+    } else {
+        // Forget old samples with a time constant of one window
+        double decay = exp(-(t - e->last_t) / tracker.window_s);
+        e->sw *= decay; e->st *= decay; e->sx *= decay;
+        e->stt *= decay; e->stx *= decay;
+        e->up = e->up * decay + (rss >= e->last_rss);
+        e->n = e->n * decay + 1;
+
+        // Move the origin to the weighted mean time, which zeroes st
+        if (e->sw > 0) {
+            double shift = e->st / e->sw;
+            e->stt -= shift * e->st;
+            e->stx -= shift * e->sx;
+            e->st = 0;
+            e->origin += shift;
+        }
+    }
+
+    double rel_t = t - e->origin;
+    e->sw += 1;
+    e->st += rel_t;
+    e->sx += (double)rss;
+    e->stt += rel_t * rel_t;
+    e->stx += rel_t * (double)rss;
+
+    e->last_rss = rss;
+    e->last_t = t;
+    e->samples++;
+}
+
+bool leaks_init(int window_s, int cap) {
+    int buckets = 1;
+    while (buckets < cap) buckets <<= 1;
+
+    memset(&tracker, 0, sizeof(tracker));
+    tracker.entries = calloc(cap, sizeof(LeakEntry));
+    tracker.buckets = malloc(buckets * sizeof(int));
+    if (tracker.entries == NULL || tracker.buckets == NULL) {
+        fprintf(stderr, "Error: Failed to allocate leak tracker: %s\n", strerror(errno));
+        leaks_free();
+        return false;
+    }
+
+    for (int i = 0; i < buckets; i++) {
+        tracker.buckets[i] = NO_ENTRY;
+    }
+    for (int i = 0; i < cap; i++) {
+        tracker.entries[i].hash_next = (i + 1 < cap) ? i + 1 : NO_ENTRY;
+    }
+
+    tracker.bucket_mask = buckets - 1;
+    tracker.cap = cap;
+    tracker.free_head = 0;
+    tracker.lru_head = NO_ENTRY;
+    tracker.lru_tail = NO_ENTRY;
+    tracker.window_s = window_s;
+    tracker.page_size = sysconf(_SC_PAGESIZE);
+    tracker.rng = 2463534242U;
+    tracker.start_ns = 0;
+    return true;
+}
+
+void leaks_free(void) {
+    free(tracker.entries);
+    free(tracker.buckets);
+    memset(&tracker, 0, sizeof(tracker));
+}
+
+// Scan every process once and fold its RSS into the trend estimates
+void leaks_sample(uint64_t now_ns) {
+    if (tracker.entries == NULL) {
+        return;
+    }
+    if (tracker.start_ns == 0) {
+        tracker.start_ns = now_ns;
+    }
+
+    DIR *dir = opendir(PROC_PATH);
+    if (dir == NULL) {
+        fprintf(stderr, "Error opening %s: %s\n", PROC_PATH, strerror(errno));
+        return;
+    }
+
+    double t = (double)(now_ns - tracker.start_ns) / 1e9;
+    uint32_t generation = ++tracker.generation;
+    struct dirent *entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (!isdigit((unsigned char)entry->d_name[0])) {
+            continue;
+        }
+
+        pid_t pid = (pid_t)strtol(entry->d_name, NULL, 10);
+        unsigned long long starttime;
+        unsigned long rss;
+        if (!read_stat(pid, &starttime, &rss) || rss == 0) {
+            continue;   // gone, or a kernel thread
+        }
+
+        // A reused PID is a new process and starts a fresh trend
+        int idx = find_entry(pid);
+        if (idx != NO_ENTRY && tracker.entries[idx].starttime != starttime) {
+            remove_entry(idx);
+            idx = NO_ENTRY;
+        }
+        if (idx == NO_ENTRY) {
+            idx = insert_entry(pid, starttime);
+        } else {
+            lru_unlink(idx);
+            lru_push_front(idx);
+        }
+
+        tracker.entries[idx].generation = generation;
+        update_entry(&tracker.entries[idx], rss, t);
+    }
+
+    closedir(dir);
+
+    // Processes not seen in this scan have exited; they sit at the LRU tail
+    while (tracker.lru_tail != NO_ENTRY &&
+           tracker.entries[tracker.lru_tail].generation != generation) {
+        remove_entry(tracker.lru_tail);
+    }
+}
+
+// Fill out[] with the fastest steadily growing processes, fastest first
+int leaks_top(LeakReport *out, int max) {
+    int count = 0;
+
+    for (int idx = tracker.lru_head; idx != NO_ENTRY; idx = tracker.entries[idx].lru_next) {
+        const LeakEntry *e = &tracker.entries[idx];
+        // A short observation cannot tell a leak from a warm-up
+        if (e->samples < MIN_LEAK_SAMPLES || e->n <= 0 ||
+            e->last_t - e->t0 < MIN_WINDOW_SPAN * tracker.window_s) {
+            continue;
+        }
+
+        double slope = entry_slope(e);
+        double monotonic = e->up / e->n;
+        if (slope * tracker.window_s < MIN_WINDOW_GROWTH || monotonic < MIN_MONOTONIC) {
+            continue;
+        }
+
+        // Insertion into a short sorted array keeps this O(processes * max)
+        int pos = count < max ? count : max;
+        while (pos > 0 && out[pos - 1].slope < slope) {
+            if (pos < max) out[pos] = out[pos - 1];
+            pos--;
+        }
+        if (pos >= max) {
+            continue;
+        }
+
+        LeakReport *r = &out[pos];
+        r->pid = e->pid;
+        r->rss = e->last_rss;
+        r->slope = slope;
+        r->monotonic = monotonic;
+        r->tracked_s = e->last_t - e->t0;
+        if (count < max) count++;
+    }
+
+    // Names are only needed for the reported few, and may change on exec
+    for (int i = 0; i < count; i++) {
+        read_comm(out[i].pid, out[i].comm, sizeof(out[i].comm));
+    }
+
+    return count;
+}
+
+int leaks_tracked(void) {
+    return tracker.used;
+}
+
+size_t leaks_state_bytes(void) {
+    return (size_t)tracker.cap * sizeof(LeakEntry) +
+           (size_t)(tracker.bucket_mask + 1) * sizeof(int);
+}
@@ -6,14 +6,27 @@
 #include <string.h>
 #include "../include/args.h"
 #include "../include/memory.h"
+#include "../include/swap.h"
+#include "../include/alert.h"
+#include "../include/sampler.h"
+#include "../include/forecast.h"
+#include "../include/leaks.h"
+#include "../include/slab.h"
+#include "../include/fincore.h"
+#include "../include/smaps.h"
+#include "../include/zones.h"
+#include "../include/procio.h"
+#include "../include/profile.h"
+#include "../include/probe.h"
 #include "../include/display.h"
 #include "../include/utils.h"
 #include "../include/common.h"
 
 #define DELUXE_MODE 1
-#define DEFAULT_UPDATE_INTERVAL 1
-#define MAX_UPDATE_INTERVAL 3600
+#define DEFAULT_UPDATE_INTERVAL_MS 1000
+#define MAX_UPDATE_INTERVAL_MS (3600 * 1000)
 #define MAX_REPEAT_COUNT 1000
+#define LEAKS_DEFAULT_INTERVAL_MS 5000
 
 // Global flag for signal handling
 static volatile sig_atomic_t keep_running = 1;
@@ -47,28 +60,73 @@ static void initialize_program(ProgramOptions *opts) {
         exit(EXIT_FAILURE);
     }
 
+    // Per-tick procfs reads, batched through io_uring when requested
+    if (!procio_init(opts->io_backend)) {
+        exit(EXIT_FAILURE);
+    }
+
+    if (opts->profile) {
+        profile_init();
+    }
+
     // Setup deluxe mode if enabled
     if (opts->display_mode == DELUXE_MODE) {
         show_loading_animation();
         setup_terminal();
         
         // Set default update interval for deluxe mode if not specified
-        if (opts->repeat_seconds == 0) {
-            opts->repeat_seconds = DEFAULT_UPDATE_INTERVAL;
+        if (opts->repeat_ms == 0) {
+            opts->repeat_ms = DEFAULT_UPDATE_INTERVAL_MS;
+        }
+    }
+
+    // ETA fields read 0 ("now") unless the forecaster runs
+    if (alert_uses_field("available_eta_s") || alert_uses_field("swap_free_eta_s")) {
+        opts->forecast = 1;
+    }
+
+    // Alert rules and forecasts only make sense when watching
+    if ((alert_rule_count() > 0 || opts->forecast) && opts->repeat_ms == 0) {
+        opts->repeat_ms = DEFAULT_UPDATE_INTERVAL_MS;
+    }
+
+    // Fault latencies exist only while the probe runs; without it they read 0
+    if (opts->probe_pages == 0 && (alert_uses_field("fault_p50_ns") ||
+                                   alert_uses_field("fault_p99_ns") ||
+                                   alert_uses_field("fault_max_ns"))) {
+        fprintf(stderr, "Error: fault_*_ns alert rules need --probe PAGES\n");
+        exit(EXIT_FAILURE);
+    }
+    if (opts->probe_pages > 0 && !probe_init(opts->probe_pages)) {
+        exit(EXIT_FAILURE);
+    }
+
+    // Trends need a series of samples
+    if (opts->view == VIEW_LEAKS) {
+        if (!leaks_init(opts->leak_window, opts->leak_cap)) {
+            exit(EXIT_FAILURE);
+        }
+        if (opts->repeat_ms == 0) {
+            opts->repeat_ms = LEAKS_DEFAULT_INTERVAL_MS;
         }
     }
+
+    // The adaptive scheduler replaces the fixed interval
+    if (opts->adaptive_min_ms > 0) {
+        opts->repeat_ms = opts->adaptive_min_ms;
+    }
 }
 
 // Validate and adjust program options
 static void validate_options(ProgramOptions *opts) {
     // Validate update interval
-    if (opts->repeat_seconds < 0) {
+    if (opts->repeat_ms < 0) {
         fprintf(stderr, "Warning: Negative update interval corrected to 0\n");
-        opts->repeat_seconds = 0;
-    } else if (opts->repeat_seconds > MAX_UPDATE_INTERVAL) {
+        opts->repeat_ms = 0;
+    } else if (opts->repeat_ms > MAX_UPDATE_INTERVAL_MS) {
         fprintf(stderr, "Warning: Update interval limited to %d seconds\n", 
-                MAX_UPDATE_INTERVAL);
-        opts->repeat_seconds = MAX_UPDATE_INTERVAL;
+                MAX_UPDATE_INTERVAL_MS / 1000);
+        opts->repeat_ms = MAX_UPDATE_INTERVAL_MS;
     }
 
     // Validate repeat count
@@ -85,9 +143,26 @@ static void validate_options(ProgramOptions *opts) {
 static void display_loop(ProgramOptions *opts) {
     int count = 0;
     const int is_deluxe_mode = (opts->display_mode == DELUXE_MODE);
+    AdaptiveSampler sampler;
+    Forecaster forecaster;
+    uint64_t prev_sample_ns = 0;
+
+    if (opts->adaptive_min_ms > 0) {
+        sampler_init(&sampler, opts->adaptive_min_ms, opts->adaptive_max_ms,
+                     opts->adaptive_threshold);
+    }
+    if (opts->forecast) {
+        forecast_init(&forecaster);
+    }
     
     while (keep_running && (count < opts->repeat_count || opts->repeat_count == 0)) {
+        uint64_t stage_ns = PROFILE_BEGIN();
+        procio_begin_tick();
+        PROFILE_END(PROF_READ, stage_ns);
+
+        stage_ns = PROFILE_BEGIN();
         MemoryInfo info = get_memory_info();
+        uint64_t now_ns = monotonic_ns();
         
         // Check if memory info retrieval was successful
         if (info.total == 0) {
@@ -95,24 +170,103 @@ static void display_loop(ProgramOptions *opts) {
             break;
         }
 
-        // Display memory information based on mode
-        if (is_deluxe_mode) {
-            display_memory_deluxe(&info, opts);
+        // Record the real gap so consumers can compute rates across varying intervals
+        info.interval_ms = prev_sample_ns ? (now_ns - prev_sample_ns + 500000) / 1000000 : 0;
+        prev_sample_ns = now_ns;
+
+        if (opts->probe_pages > 0) {
+            uint64_t probe_ns = PROFILE_BEGIN();
+            probe_run(&info);
+            PROFILE_END(PROF_PROBE, probe_ns);
+        }
+        if (opts->forecast) {
+            forecast_update(&forecaster, &info, now_ns);
+        }
+
+        // Evaluate alert rules before rendering so events are not delayed
+        int triggered = alert_evaluate(&info, now_ns);
+
+        // Trends need every sample, whether or not it is rendered
+        if (opts->view == VIEW_LEAKS) {
+            leaks_sample(now_ns);
+        }
+
+        if (!opts->quiet) {
+            // Per-device swap and compression stats are optional extras
+            SwapDetails swap;
+            SwapDetails *swap_ptr = get_swap_details(&info, &swap) ? &swap : NULL;
+
+            // Views with their own data sources collect before rendering
+            const FincoreReport *report = NULL;
+            const ZoneReport *zones = NULL;
+            SmapsSummary summary;
+            bool collected = true;
+
+            if (opts->view == VIEW_SLAB) {
+                collected = slab_sample(opts->slabinfo_path, now_ns);
+            } else if (opts->view == VIEW_FINCORE) {
+                report = fincore_scan(opts->fincore_paths, opts->fincore_path_count);
+                collected = report != NULL;
+            } else if (opts->view == VIEW_SMAPS) {
+                collected = smaps_read(opts->pid, &summary);
+            } else if (opts->view == VIEW_ZONES) {
+                zones = zones_read(ZONEINFO_PATH, BUDDYINFO_PATH);
+                collected = zones != NULL;
+            }
+            PROFILE_END(PROF_PARSE, stage_ns);
+
+            if (!collected) {
+                break;
+            }
+
+            // Display memory information based on mode
+            stage_ns = PROFILE_BEGIN();
+            if (opts->view == VIEW_BREAKDOWN) {
+                display_breakdown(&info, opts);
+            } else if (opts->view == VIEW_LEAKS) {
+                display_leaks(opts);
+            } else if (opts->view == VIEW_SLAB) {
+                display_slab(&info, opts);
+            } else if (opts->view == VIEW_FINCORE) {
+                display_fincore(report, opts);
+            } else if (opts->view == VIEW_SMAPS) {
+                display_smaps(&summary, opts);
+            } else if (opts->view == VIEW_ZONES) {
+                display_zones(zones, opts);
+            } else if (opts->single_line) {
+                display_memory_line(&info, opts);
+            } else if (is_deluxe_mode) {
+                display_memory_deluxe(&info, swap_ptr, opts);
+            } else {
+                display_memory(&info, swap_ptr, opts);
+            }
+            PROFILE_END(PROF_BUILD, stage_ns);
+
+            stage_ns = PROFILE_BEGIN();
+            PROFILE_COUNT_WRITE();
+            fflush(stdout);
+            PROFILE_END(PROF_WRITE, stage_ns);
         } else {
-            display_memory(&info, opts);
+            PROFILE_END(PROF_PARSE, stage_ns);
+        }
+        PROFILE_END_TICK();
+
+        if (triggered > 0 && opts->alert_exit) {
+            break;
         }
 
         // If this is not a repeat or it's the last iteration, break
-        if (opts->repeat_seconds <= 0 || 
+        if (opts->repeat_ms <= 0 || 
            (opts->repeat_count > 0 && count >= opts->repeat_count - 1)) {
             break;
         }
 
         // Sleep for the specified interval
-        if (opts->repeat_seconds >= 1) {
-            sleep(opts->repeat_seconds);
+        fflush(stdout);
+        if (opts->adaptive_min_ms > 0) {
+            sleep_ms(sampler_next_interval(&sampler, &info, now_ns));
         } else {
-            usleep(opts->repeat_seconds * 1000000);
+            sleep_ms(opts->repeat_ms);
         }
         
         count++;
@@ -138,6 +292,10 @@ static void signal_handler(int signum) {
 // Cleanup handler implementation
 static void cleanup_handler(void) {
     cleanup();  // Call the original cleanup function
+    leaks_free();
+    slab_free();
+    procio_shutdown();
+    probe_free();
     fflush(stdout);
     fflush(stderr);
 }
@@ -154,6 +312,8 @@ int main(int argc, char **argv) {
     
     // Enter main display loop
     display_loop(&opts);
+    profile_report(stderr);
     
-    return EXIT_SUCCESS;
+    // A triggered alert is reported through the exit status as well
+    return alert_exit_status() ? alert_exit_status() : EXIT_SUCCESS;
 }
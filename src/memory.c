@@ -9,9 +9,9 @@
 #include <stddef.h>     // For offsetof macro
 #include <time.h>       // For nanosleep
 #include "memory.h"
+#include "procio.h"
 
 #define MEMINFO_PATH "/proc/meminfo"
-#define LINE_BUFFER_SIZE 256
 #define KB_TO_BYTES 1024UL
 #define MAX_RETRIES 3
 #define FIELD_NAME_MAX 32
@@ -28,6 +28,18 @@ typedef struct {
     unsigned long inactive;
     unsigned long swap_total;
     unsigned long swap_free;
+    unsigned long zswap;
+    unsigned long zswapped;
+    unsigned long slab_reclaimable;
+    unsigned long slab_unreclaimable;
+    unsigned long shmem;
+    unsigned long anon_pages;
+    unsigned long kernel_stack;
+    unsigned long page_tables;
+    unsigned long sec_page_tables;
+    unsigned long vmalloc_used;
+    unsigned long percpu;
+    unsigned long hugetlb;
 } MemInfoRaw;
 
 // Field mapping structure for more maintainable code
@@ -35,6 +47,7 @@ typedef struct {
     const char *name;
     size_t offset;
     size_t name_len;
+    bool required;      // optional fields depend on kernel version/config
 } MemField;
 
 // Safe multiplication checking for overflow
@@ -62,30 +75,50 @@ static bool parse_memory_line(const char *line, unsigned long *value) {
 
 // Read memory information from /proc/meminfo
 static bool read_proc_meminfo(MemInfoRaw *info) {
-    FILE *fp = NULL;
+    static int handle = -1;     // kept open across samples
+    const char *data = NULL;
     int retries = 0;
     bool success = false;
     
     // Initialize field mappings for cleaner code
     // Each entry contains: the field name, its offset in the structure, and the name length
     const MemField fields[] = {
-        {"MemTotal:",      offsetof(MemInfoRaw, mem_total),     9},
-        {"MemFree:",       offsetof(MemInfoRaw, mem_free),      8},
-        {"MemAvailable:",  offsetof(MemInfoRaw, mem_available), 13},
-        {"Buffers:",       offsetof(MemInfoRaw, buffers),       8},
-        {"Cached:",        offsetof(MemInfoRaw, cached),        7},
-        {"SwapCached:",    offsetof(MemInfoRaw, swap_cached),   11},
-        {"Active:",        offsetof(MemInfoRaw, active),        7},
-        {"Inactive:",      offsetof(MemInfoRaw, inactive),      9},
-        {"SwapTotal:",     offsetof(MemInfoRaw, swap_total),    10},
-        {"SwapFree:",      offsetof(MemInfoRaw, swap_free),     9}
+        {"MemTotal:",      offsetof(MemInfoRaw, mem_total),     9,  true},
+        {"MemFree:",       offsetof(MemInfoRaw, mem_free),      8,  true},
+        {"MemAvailable:",  offsetof(MemInfoRaw, mem_available), 13, true},
+        {"Buffers:",       offsetof(MemInfoRaw, buffers),       8,  true},
+        {"Cached:",        offsetof(MemInfoRaw, cached),        7,  true},
+        {"SwapCached:",    offsetof(MemInfoRaw, swap_cached),   11, true},
+        {"Active:",        offsetof(MemInfoRaw, active),        7,  true},
+        {"Inactive:",      offsetof(MemInfoRaw, inactive),      9,  true},
+        {"SwapTotal:",     offsetof(MemInfoRaw, swap_total),    10, true},
+        {"SwapFree:",      offsetof(MemInfoRaw, swap_free),     9,  true},
+        {"Zswap:",         offsetof(MemInfoRaw, zswap),         6,  false},
+        {"Zswapped:",      offsetof(MemInfoRaw, zswapped),      9,  false},
+        {"SReclaimable:",  offsetof(MemInfoRaw, slab_reclaimable),   13, false},
+        {"SUnreclaim:",    offsetof(MemInfoRaw, slab_unreclaimable), 11, false},
+        {"Shmem:",         offsetof(MemInfoRaw, shmem),         6,  false},
+        {"AnonPages:",     offsetof(MemInfoRaw, anon_pages),    10, false},
+        {"KernelStack:",   offsetof(MemInfoRaw, kernel_stack),  12, false},
+        {"PageTables:",    offsetof(MemInfoRaw, page_tables),   11, false},
+        {"SecPageTables:", offsetof(MemInfoRaw, sec_page_tables), 14, false},
+        {"VmallocUsed:",   offsetof(MemInfoRaw, vmalloc_used),  12, false},
+        {"Percpu:",        offsetof(MemInfoRaw, percpu),        7,  false},
+        {"Hugetlb:",       offsetof(MemInfoRaw, hugetlb),       8,  false}
     };
     const int num_fields = sizeof(fields) / sizeof(MemField);
+    int num_required = 0;
+    for (int i = 0; i < num_fields; i++) {
+        num_required += fields[i].required;
+    }
     
     // Try opening the file with retries for resilience
-    while (retries < MAX_RETRIES && fp == NULL) {
-        fp = fopen(MEMINFO_PATH, "r");
-        if (fp == NULL) {
+    while (retries < MAX_RETRIES && data == NULL) {
+        if (handle < 0) {
+            handle = procio_register(MEMINFO_PATH);
+        }
+        data = handle >= 0 ? procio_read(handle, NULL) : NULL;
+        if (data == NULL) {
             retries++;
             // Small delay before retry
             struct timespec ts = {0, 100000000}; // 100ms
@@ -93,50 +126,47 @@ static bool read_proc_meminfo(MemInfoRaw *info) {
         }
     }
     
-    if (fp == NULL) {
-        fprintf(stderr, "Error opening %s after %d attempts: %s\n", 
+    if (data == NULL) {
+        fprintf(stderr, "Error reading %s after %d attempts: %s\n", 
                 MEMINFO_PATH, MAX_RETRIES, strerror(errno));
         return false;
     }
 
-    char line[LINE_BUFFER_SIZE];
     int found_count = 0;
+    const char *next;
+
+    for (const char *line = data; *line != '\0'; line = next) {
+        const char *eol = strchr(line, '\n');
+        int line_len = eol ? (int)(eol - line) : (int)strlen(line);
+        next = line + line_len + (eol != NULL);
 
-    while (fgets(line, sizeof(line), fp)) {
         // Skip empty lines
-        if (line[0] == '\n' || line[0] == '\0') continue;
+        if (line_len == 0) continue;
         
         bool line_matched = false;
         
         // Check each field
         for (int i = 0; i < num_fields && !line_matched; i++) {
             if (strncmp(line, fields[i].name, fields[i].name_len) == 0) {
-                // Special case for "Cached:" to avoid matching "SwapCached:"
-                if (strcmp(fields[i].name, "Cached:") == 0 && 
-                    strstr(line, "SwapCached:") != NULL) {
-                    continue;
-                }
-                
+                // Prefix match on the line start, so "Cached:" never matches "SwapCached:"
                 // Get the address of the target field using the offset
                 unsigned long *target = (unsigned long*)((char*)info + fields[i].offset);
                 
                 if (parse_memory_line(line, target)) {
-                    found_count++;
+                    found_count += fields[i].required;
                     line_matched = true;
                 } else {
-                    fprintf(stderr, "Error parsing line: %s", line);
+                    fprintf(stderr, "Error parsing line: %.*s\n", line_len, line);
                 }
             }
         }
     }
 
-    fclose(fp);
-
     // Check if we found all required fields
-    success = (found_count == num_fields);
+    success = (found_count == num_required);
     if (!success) {
         fprintf(stderr, "Warning: Only found %d of %d required memory fields\n",
-                found_count, num_fields);
+                found_count, num_required);
     }
 
     return success;
@@ -152,31 +182,42 @@ static bool calculate_memory_values(const MemInfoRaw *raw, MemoryInfo *info) {
     info->cached = raw->cached;
     info->swap_total = raw->swap_total;
     info->swap_free = raw->swap_free;
+    info->zswap = raw->zswap;
+    info->zswapped = raw->zswapped;
+    info->slab_reclaimable = raw->slab_reclaimable;
+    info->slab_unreclaimable = raw->slab_unreclaimable;
 
-    // Calculate used memory (total - free - buffers - cached)
-    unsigned long total_deductions = 0;
-    
-    // Check for overflow in addition
-    if (raw->mem_free > ULONG_MAX - raw->buffers ||
-        raw->mem_free + raw->buffers > ULONG_MAX - raw->cached) {
-        fprintf(stderr, "Warning: Overflow detected in memory calculations\n");
+    info->page_cache = raw->cached;
+    info->swap_cached = raw->swap_cached;
+    info->anon_pages = raw->anon_pages;
+    info->kernel_stack = raw->kernel_stack;
+    info->page_tables = raw->page_tables;
+    info->sec_page_tables = raw->sec_page_tables;
+    info->vmalloc_used = raw->vmalloc_used;
+    info->percpu = raw->percpu;
+    info->hugetlb = raw->hugetlb;
+
+    // procps-compatible: cache includes reclaimable slab, shared is Shmem
+    if (raw->cached > ULONG_MAX - raw->slab_reclaimable) {
+        fprintf(stderr, "Warning: Overflow detected in cache calculation\n");
+        return false;
+    }
+    info->cached = raw->cached + raw->slab_reclaimable;
+    info->shared = raw->shmem;
+
+    // used = total - available as procps-ng 4 reports it; total - free if
+    // MemAvailable is missing or exceeds the total
+    if (raw->mem_free > raw->mem_total) {
         info->used = 0;
+    } else if (raw->mem_available == 0 || raw->mem_available > raw->mem_total) {
+        info->used = raw->mem_total - raw->mem_free;
     } else {
-        total_deductions = raw->mem_free + raw->buffers + raw->cached;
-        info->used = (total_deductions > raw->mem_total) ? 0 : raw->mem_total - total_deductions;
+        info->used = raw->mem_total - raw->mem_available;
     }
 
     // Calculate swap used
     info->swap_used = (raw->swap_free > raw->swap_total) ? 0 : raw->swap_total - raw->swap_free;
 
-    // Check for overflow in active + inactive
-    if (raw->active > ULONG_MAX - raw->inactive) {
-        fprintf(stderr, "Warning: Overflow detected in shared memory calculation\n");
-        info->shared = 0;
-    } else {
-        info->shared = raw->active + raw->inactive;
-    }
-
     return true;
 }
 
@@ -271,6 +312,52 @@ MemoryInfo get_memory_info(void) {
     return info;
 }
 
+static void add_part(MemoryBreakdown *breakdown, const char *name, unsigned long bytes) {
+    if (breakdown->count < MEMORY_PART_MAX) {
+        breakdown->parts[breakdown->count].name = name;
+        breakdown->parts[breakdown->count].bytes = bytes;
+        breakdown->count++;
+    }
+}
+
+// Partition MemTotal into non-overlapping meminfo components. Cached already
+// contains Shmem, so file pages are Buffers + Cached - Shmem; AnonPages covers
+// transparent huge pages, and Hugetlb pages are neither free nor cached.
+// With CONFIG_VMAP_STACK (the x86_64 and arm64 default) task stacks are
+// vmalloc'd, so KernelStack is also inside VmallocUsed; the Vmalloc part
+// leaves them out whenever VmallocUsed is large enough to contain them.
+void memory_breakdown(const MemoryInfo *info, MemoryBreakdown *breakdown) {
+    unsigned long file = info->buffers + info->page_cache;
+    file = file > info->shared ? file - info->shared : 0;
+
+    unsigned long vmalloc = info->vmalloc_used;
+    if (vmalloc >= info->kernel_stack) {
+        vmalloc -= info->kernel_stack;
+    }
+
+    memset(breakdown, 0, sizeof(*breakdown));
+    add_part(breakdown, "Free", info->free);
+    add_part(breakdown, "Anon", info->anon_pages);
+    add_part(breakdown, "File", file);
+    add_part(breakdown, "Shmem", info->shared);
+    add_part(breakdown, "SwapCached", info->swap_cached);
+    add_part(breakdown, "SReclaimable", info->slab_reclaimable);
+    add_part(breakdown, "SUnreclaim", info->slab_unreclaimable);
+    add_part(breakdown, "KernelStack", info->kernel_stack);
+    add_part(breakdown, "PageTables", info->page_tables);
+    add_part(breakdown, "SecPageTables", info->sec_page_tables);
+    add_part(breakdown, "Vmalloc", vmalloc);
+    add_part(breakdown, "Percpu", info->percpu);
+    add_part(breakdown, "Hugetlb", info->hugetlb);
+    add_part(breakdown, "Zswap", info->zswap);      // compressed pool, in no other field
+
+    long accounted = 0;
+    for (int i = 0; i < breakdown->count; i++) {
+        accounted += (long)breakdown->parts[i].bytes;
+    }
+    breakdown->unaccounted = (long)info->total - accounted;
+}
+
 // New function to print memory information in human-readable format
 void print_memory_info(const MemoryInfo *info) {
     const double GB = 1024.0 * 1024.0 * 1024.0;
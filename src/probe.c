@@ -0,0 +1,69 @@
+// src/probe.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "../include/probe.h"
+#include "../include/utils.h"
+
+static uint32_t *latencies;     // per-page fault time of the current sample
+static int probe_pages;
+static long page_size;
+static bool warned;
+
+static int compare_latency(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+bool probe_init(int pages) {
+    latencies = malloc((size_t)pages * sizeof(*latencies));
+    if (latencies == NULL) {
+        fprintf(stderr, "Error: Failed to allocate probe state for %d pages\n", pages);
+        return false;
+    }
+    probe_pages = pages;
+    page_size = sysconf(_SC_PAGESIZE);
+    return true;
+}
+
+// Fault in probe_pages fresh pages and store the latency percentiles in info
+bool probe_run(MemoryInfo *info) {
+    size_t len = (size_t)probe_pages * page_size;
+
+    char *region = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        if (!warned) {
+            fprintf(stderr, "Warning: Allocation probe mmap failed: %s\n", strerror(errno));
+            warned = true;
+        }
+        return false;
+    }
+
+    // One fault per base page, not one per huge page
+    madvise(region, len, MADV_NOHUGEPAGE);
+
+    for (int i = 0; i < probe_pages; i++) {
+        uint64_t start_ns = monotonic_ns();
+        *(volatile char *)(region + (size_t)i * page_size) = 1;
+        uint64_t elapsed_ns = monotonic_ns() - start_ns;
+        latencies[i] = elapsed_ns > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed_ns;
+    }
+    munmap(region, len);
+
+    qsort(latencies, probe_pages, sizeof(*latencies), compare_latency);
+    info->fault_pages = probe_pages;
+    info->fault_p50_ns = latencies[(probe_pages - 1) / 2];
+    info->fault_p99_ns = latencies[(int)((probe_pages - 1) * 0.99 + 0.5)];
+    info->fault_max_ns = latencies[probe_pages - 1];
+    return true;
+}
+
+void probe_free(void) {
+    free(latencies);
+    latencies = NULL;
+    probe_pages = 0;
+}
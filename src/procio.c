@@ -0,0 +1,363 @@
+// src/procio.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#include "../include/procio.h"
+
+typedef struct {
+    char path[64];
+    int fd;
+    char *buf;                  // slice of the shared buffer arena
+    size_t len;
+    int status;                 // 0 or -errno from the last read
+    bool warned;                // truncation already reported
+    unsigned long tick;         // tick the buffer was filled in
+} ProcFile;
+
+// Minimal io_uring state, driven through the raw syscalls
+typedef struct {
+    int fd;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    size_t sqes_size;
+    bool files_registered;      // fds registered; SQEs use IOSQE_FIXED_FILE
+    bool buffers_registered;    // arena registered; SQEs use READ_FIXED
+    int registered_count;
+} Uring;
+
+static ProcFile files[PROCIO_MAX_FILES];
+static int file_count;
+static char *arena;
+static unsigned long current_tick;
+static int backend = PROCIO_BACKEND_PREAD;
+static ProcioStats stats;
+static Uring ring = {.fd = -1};
+
+// Record a completed read of n bytes or -errno.  A full buffer means the file
+// did not fit, so the read fails with EFBIG rather than returning a prefix.
+static void complete_read(ProcFile *f, long n) {
+    stats.reads++;
+    if (n >= PROCIO_BUFFER_SIZE - 1) {
+        if (!f->warned) {
+            fprintf(stderr, "Warning: %s exceeds %d bytes; not reading it\n",
+                    f->path, PROCIO_BUFFER_SIZE - 1);
+            f->warned = true;
+        }
+        n = -EFBIG;
+    }
+    if (n < 0) {
+        f->status = (int)n;
+        return;
+    }
+
+    f->len = n;
+    f->buf[n] = '\0';
+    f->status = 0;
+    f->tick = current_tick;
+    stats.bytes += n;
+}
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static void uring_teardown(void) {
+    if (ring.sqes != NULL) munmap(ring.sqes, ring.sqes_size);
+    if (ring.cq_ring != NULL && ring.cq_ring != ring.sq_ring) munmap(ring.cq_ring, ring.cq_ring_size);
+    if (ring.sq_ring != NULL) munmap(ring.sq_ring, ring.sq_ring_size);
+    if (ring.fd >= 0) close(ring.fd);
+    memset(&ring, 0, sizeof(ring));
+    ring.fd = -1;
+}
+
+static bool uring_setup(void) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+
+    ring.fd = sys_io_uring_setup(PROCIO_MAX_FILES, &p);
+    if (ring.fd < 0) {
+        ring.fd = -1;
+        return false;
+    }
+
+    ring.sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring.cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring.cq_ring_size > ring.sq_ring_size) ring.sq_ring_size = ring.cq_ring_size;
+        ring.cq_ring_size = ring.sq_ring_size;
+    }
+
+    ring.sq_ring = mmap(NULL, ring.sq_ring_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+    if (ring.sq_ring == MAP_FAILED) {
+        ring.sq_ring = NULL;
+        uring_teardown();
+        return false;
+    }
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring.cq_ring = ring.sq_ring;
+    } else {
+        ring.cq_ring = mmap(NULL, ring.cq_ring_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_CQ_RING);
+        if (ring.cq_ring == MAP_FAILED) {
+            ring.cq_ring = NULL;
+            uring_teardown();
+            return false;
+        }
+    }
+
+    ring.sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring.sqes = mmap(NULL, ring.sqes_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQES);
+    if (ring.sqes == MAP_FAILED) {
+        ring.sqes = NULL;
+        uring_teardown();
+        return false;
+    }
+
+    char *sq = ring.sq_ring, *cq = ring.cq_ring;
+    ring.sq_head = (unsigned *)(sq + p.sq_off.head);
+    ring.sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    ring.sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    ring.sq_array = (unsigned *)(sq + p.sq_off.array);
+    ring.cq_head = (unsigned *)(cq + p.cq_off.head);
+    ring.cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    ring.cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    ring.cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+    // Pin the whole arena once; without it (RLIMIT_MEMLOCK) plain READ still works
+    struct iovec iov = {arena, (size_t)PROCIO_MAX_FILES * PROCIO_BUFFER_SIZE};
+    ring.buffers_registered = sys_io_uring_register(ring.fd, IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+    return true;
+}
+
+// The fixed file table is replaced whenever files were added since the last tick
+static void uring_register_files(void) {
+    if (ring.registered_count == file_count) {
+        return;
+    }
+    if (ring.files_registered) {
+        sys_io_uring_register(ring.fd, IORING_UNREGISTER_FILES, NULL, 0);
+    }
+
+    int fds[PROCIO_MAX_FILES];
+    for (int i = 0; i < file_count; i++) {
+        fds[i] = files[i].fd;
+    }
+    ring.files_registered = sys_io_uring_register(ring.fd, IORING_REGISTER_FILES, fds, file_count) == 0;
+    ring.registered_count = file_count;
+}
+
+static void uring_read_all(void) {
+    uring_register_files();
+
+    unsigned tail = *ring.sq_tail;
+    unsigned mask = *ring.sq_mask;
+
+    for (int i = 0; i < file_count; i++) {
+        unsigned idx = tail & mask;
+        struct io_uring_sqe *sqe = &ring.sqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+
+        sqe->opcode = ring.buffers_registered ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        sqe->buf_index = 0;
+        sqe->fd = ring.files_registered ? i : files[i].fd;
+        sqe->flags = ring.files_registered ? IOSQE_FIXED_FILE : 0;
+        sqe->off = 0;
+        sqe->addr = (unsigned long)files[i].buf;
+        sqe->len = PROCIO_BUFFER_SIZE - 1;
+        sqe->user_data = i;
+
+        ring.sq_array[idx] = idx;
+        tail++;
+    }
+    __atomic_store_n(ring.sq_tail, tail, __ATOMIC_RELEASE);
+
+    // The kernel may take fewer SQEs than queued; push the rest before reaping
+    int submitted = 0;
+    while (submitted < file_count) {
+        int n = sys_io_uring_enter(ring.fd, file_count - submitted, file_count - submitted,
+                                   IORING_ENTER_GETEVENTS);
+        stats.syscalls++;
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            // Drop what the kernel did not take so it is not read again next
+            // tick; those files keep a stale tick and procio_read() preads them
+            unsigned head = __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE);
+            __atomic_store_n(ring.sq_tail, head, __ATOMIC_RELEASE);
+            break;
+        }
+        submitted += n;
+    }
+
+    unsigned head = *ring.cq_head;
+    unsigned cq_mask = *ring.cq_mask;
+    int reaped = 0;
+
+    while (reaped < submitted) {
+        unsigned cq_tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+        if (head == cq_tail) {
+            // Completions trickle in from io-wq for procfs; wait for the rest
+            sys_io_uring_enter(ring.fd, 0, submitted - reaped, IORING_ENTER_GETEVENTS);
+            stats.syscalls++;
+            continue;
+        }
+
+        const struct io_uring_cqe *cqe = &ring.cqes[head & cq_mask];
+        complete_read(&files[cqe->user_data], cqe->res);
+        head++;
+        reaped++;
+    }
+    __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+}
+
+static void pread_file(ProcFile *f) {
+    ssize_t n;
+    do {
+        n = pread(f->fd, f->buf, PROCIO_BUFFER_SIZE - 1, 0);
+    } while (n < 0 && errno == EINTR);
+
+    stats.syscalls++;
+    complete_read(f, n < 0 ? -errno : n);
+}
+
+bool procio_init(int requested) {
+    if (arena == NULL) {
+        arena = malloc((size_t)PROCIO_MAX_FILES * PROCIO_BUFFER_SIZE);
+        if (arena == NULL) {
+            fprintf(stderr, "Error: Failed to allocate procfs read buffers\n");
+            return false;
+        }
+    }
+
+    backend = PROCIO_BACKEND_PREAD;
+    if (requested == PROCIO_BACKEND_URING) {
+        if (uring_setup()) {
+            backend = PROCIO_BACKEND_URING;
+        } else {
+            fprintf(stderr, "Warning: io_uring unavailable (%s), using pread\n", strerror(errno));
+        }
+    }
+    return true;
+}
+
+int procio_backend(void) {
+    return backend;
+}
+
+// Open path once and return a handle for procio_read(); registering the same
+// path twice returns the existing handle
+int procio_register(const char *path) {
+    if (arena == NULL && !procio_init(PROCIO_BACKEND_PREAD)) {
+        return -1;
+    }
+
+    for (int i = 0; i < file_count; i++) {
+        if (strcmp(files[i].path, path) == 0) {
+            return i;
+        }
+    }
+    if (file_count >= PROCIO_MAX_FILES || strlen(path) >= sizeof(files[0].path)) {
+        errno = ENOSPC;
+        return -1;
+    }
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ProcFile *f = &files[file_count];
+    memset(f, 0, sizeof(*f));
+    snprintf(f->path, sizeof(f->path), "%s", path);
+    f->fd = fd;
+    f->buf = arena + (size_t)file_count * PROCIO_BUFFER_SIZE;
+    f->tick = 0;
+    return file_count++;
+}
+
+void procio_begin_tick(void) {
+    current_tick++;
+    stats.ticks++;
+
+    if (file_count == 0) {
+        return;
+    }
+
+    if (backend == PROCIO_BACKEND_URING) {
+        uring_read_all();
+    } else {
+        for (int i = 0; i < file_count; i++) {
+            pread_file(&files[i]);
+        }
+    }
+}
+
+// Contents of a registered file for the current tick, NUL-terminated
+const char *procio_read(int handle, size_t *len) {
+    if (handle < 0 || handle >= file_count) {
+        errno = EBADF;
+        return NULL;
+    }
+
+    ProcFile *f = &files[handle];
+    if (f->tick != current_tick || current_tick == 0) {
+        pread_file(f);
+    }
+    if (f->status < 0) {
+        errno = -f->status;
+        return NULL;
+    }
+
+    if (len != NULL) {
+        *len = f->len;
+    }
+    return f->buf;
+}
+
+// Account a procfs read() made outside procio (LineStream, slabinfo, the
+// per-process files of --leaks) so the --profile totals cover every view
+void procio_count(size_t bytes) {
+    stats.syscalls++;
+    stats.reads++;
+    stats.bytes += bytes;
+}
+
+const ProcioStats *procio_stats(void) {
+    return &stats;
+}
+
+void procio_shutdown(void) {
+    uring_teardown();
+    for (int i = 0; i < file_count; i++) {
+        close(files[i].fd);
+    }
+    file_count = 0;
+    free(arena);
+    arena = NULL;
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,151 @@
+// src/profile.c
+#include <stdio.h>
+#include <stdio_ext.h>  // For __fpending
+#include <stdlib.h>
+#include <string.h>
+#include "../include/profile.h"
+#include "../include/procio.h"
+
+#define SUB_BITS 3
+#define SUB_BUCKETS (1 << SUB_BITS)
+#define BUCKET_COUNT (64 * SUB_BUCKETS)
+#define STDOUT_BUFFER_SIZE (64 * 1024)
+
+typedef struct {
+    uint64_t buckets[BUCKET_COUNT];
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t pending_ns;        // time accumulated in the current tick
+    bool pending;
+} StageHistogram;
+
+static const char *const STAGE_NAMES[PROF_STAGE_COUNT] = {
+    "read", "parse", "probe", "format", "build", "write"
+};
+
+bool profile_enabled = false;
+
+static StageHistogram stages[PROF_STAGE_COUNT];
+static uint64_t ticks;
+static uint64_t write_calls;
+static uint64_t write_bytes;
+static char stdout_buffer[STDOUT_BUFFER_SIZE];
+
+// Power of two from the top bit, refined by the next SUB_BITS bits
+static int bucket_index(uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return (int)ns;
+    }
+    int msb = 63 - __builtin_clzll(ns);
+    int sub = (int)((ns >> (msb - SUB_BITS)) & (SUB_BUCKETS - 1));
+    return (msb - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+// Largest value that falls into bucket idx
+static uint64_t bucket_upper(int idx) {
+    if (idx < SUB_BUCKETS) {
+        return (uint64_t)idx;
+    }
+    int msb = idx / SUB_BUCKETS + SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(idx % SUB_BUCKETS);
+    uint64_t base = (1ULL << msb) | (sub << (msb - SUB_BITS));
+    return base + (1ULL << (msb - SUB_BITS)) - 1;
+}
+
+static uint64_t percentile(const StageHistogram *h, double pct) {
+    if (h->count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(pct / 100 * h->count + 0.5);
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = bucket_upper(i);
+            return upper < h->max_ns ? upper : h->max_ns;
+        }
+    }
+    return h->max_ns;
+}
+
+void profile_init(void) {
+#ifdef NO_PROFILE
+    fprintf(stderr, "Warning: built with NO_PROFILE, --profile has no effect\n");
+#else
+    memset(stages, 0, sizeof(stages));
+    profile_enabled = true;
+
+    // Fully buffer stdout so rendering and writing the frame can be timed apart
+    setvbuf(stdout, stdout_buffer, _IOFBF, sizeof(stdout_buffer));
+#endif
+}
+
+void profile_add(int stage, uint64_t start_ns) {
+    StageHistogram *h = &stages[stage];
+    h->pending_ns += monotonic_ns() - start_ns;
+    h->pending = true;
+}
+
+// Called just before the timed fflush() so the bytes it writes are counted
+void profile_count_write(void) {
+    size_t pending = __fpending(stdout);
+    if (pending > 0) {
+        write_calls++;
+        write_bytes += pending;
+    }
+}
+
+// Report an outer stage without the time of a stage nested inside it
+static void exclude_stage(int outer, int inner) {
+    StageHistogram *h = &stages[outer];
+    uint64_t inner_ns = stages[inner].pending_ns;
+    h->pending_ns = h->pending_ns > inner_ns ? h->pending_ns - inner_ns : 0;
+}
+
+// Fold this tick's stage times into the histograms
+void profile_end_tick(void) {
+    // The probe runs inside parsing and format_size() inside rendering
+    exclude_stage(PROF_PARSE, PROF_PROBE);
+    exclude_stage(PROF_BUILD, PROF_FORMAT);
+
+    for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+        StageHistogram *h = &stages[i];
+        if (!h->pending) {
+            continue;
+        }
+        h->buckets[bucket_index(h->pending_ns)]++;
+        h->count++;
+        h->total_ns += h->pending_ns;
+        if (h->pending_ns > h->max_ns) h->max_ns = h->pending_ns;
+        h->pending_ns = 0;
+        h->pending = false;
+    }
+    ticks++;
+}
+
+void profile_report(FILE *out) {
+    if (!profile_enabled || ticks == 0) {
+        return;
+    }
+
+    const ProcioStats *io = procio_stats();
+
+    fprintf(out, "\nProfile (%llu ticks, microseconds per tick):\n",
+            (unsigned long long)ticks);
+    fprintf(out, "%-8s %10s %10s %10s %10s %12s\n", "STAGE", "COUNT", "P50", "P99", "MAX", "TOTAL");
+    for (int i = 0; i < PROF_STAGE_COUNT; i++) {
+        const StageHistogram *h = &stages[i];
+        fprintf(out, "%-8s %10llu %10.1f %10.1f %10.1f %12.1f\n", STAGE_NAMES[i],
+                (unsigned long long)h->count,
+                percentile(h, 50) / 1e3, percentile(h, 99) / 1e3,
+                h->max_ns / 1e3, h->total_ns / 1e3);
+    }
+    fprintf(out, "procfs: %.1f read syscalls, %.0f bytes read per tick; "
+            "stdout: %.1f writes, %.0f bytes per tick\n",
+            (double)io->syscalls / ticks, (double)io->bytes / ticks,
+            (double)write_calls / ticks, (double)write_bytes / ticks);
+}
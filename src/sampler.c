@@ -0,0 +1,85 @@
+// src/sampler.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/sampler.h"
+#include "../include/procio.h"
+
+#define PSI_MEMORY_PATH "/proc/pressure/memory"
+
+// Read the cumulative "some" stall time in microseconds
+static bool read_psi_stall(unsigned long long *stall_us) {
+    static int handle = -1;
+    static bool unavailable = false;
+
+    if (handle < 0 && !unavailable) {
+        handle = procio_register(PSI_MEMORY_PATH);
+        // PSI is disabled or the kernel predates it
+        unavailable = handle < 0;
+    }
+
+    const char *data = handle >= 0 ? procio_read(handle, NULL) : NULL;
+    if (data == NULL || strncmp(data, "some ", 5) != 0) {
+        return false;
+    }
+
+    const char *total = strstr(data, "total=");
+    return total != NULL && sscanf(total, "total=%llu", stall_us) == 1;
+}
+
+static unsigned long abs_diff(unsigned long a, unsigned long b) {
+    return a > b ? a - b : b - a;
+}
+
+void sampler_init(AdaptiveSampler *sampler, int min_ms, int max_ms, double threshold) {
+    memset(sampler, 0, sizeof(*sampler));
+    sampler->min_ms = min_ms;
+    sampler->max_ms = max_ms;
+    sampler->current_ms = min_ms;
+    sampler->threshold = threshold;
+}
+
+// Decide how long to wait before the next sample based on how much changed
+// since the previous one
+int sampler_next_interval(AdaptiveSampler *sampler, const MemoryInfo *info, uint64_t now_ns) {
+    unsigned long long stall_us = 0;
+    bool have_psi = read_psi_stall(&stall_us);
+    bool active = false;
+
+    if (sampler->have_prev && now_ns > sampler->prev_ns && info->total > 0) {
+        double elapsed_s = (double)(now_ns - sampler->prev_ns) / 1e9;
+
+        // Largest movement of used/available/swap as percent of RAM per second
+        unsigned long delta = abs_diff(info->used, sampler->prev.used);
+        unsigned long d_avail = abs_diff(info->available, sampler->prev.available);
+        unsigned long d_swap = abs_diff(info->swap_used, sampler->prev.swap_used);
+        if (d_avail > delta) delta = d_avail;
+        if (d_swap > delta) delta = d_swap;
+
+        double churn = (double)delta * 100 / info->total / elapsed_s;
+        active = churn > sampler->threshold;
+
+        // Share of wall time some task was stalled on memory
+        if (have_psi && sampler->have_psi && stall_us >= sampler->prev_stall_us) {
+            double stall = (double)(stall_us - sampler->prev_stall_us) / 1e4 / elapsed_s;
+            active = active || stall > sampler->threshold;
+        }
+    }
+
+    if (active) {
+        sampler->current_ms = sampler->min_ms;
+    } else if (sampler->have_prev) {
+        // Grow by half, at least 1 ms, so tiny --min values still back off
+        int step = sampler->current_ms / ADAPTIVE_BACKOFF_DIVISOR;
+        int next = sampler->current_ms + (step > 1 ? step : 1);
+        sampler->current_ms = next > sampler->max_ms ? sampler->max_ms : next;
+    }
+
+    sampler->prev = *info;
+    sampler->prev_ns = now_ns;
+    sampler->have_prev = true;
+    sampler->prev_stall_us = stall_us;
+    sampler->have_psi = have_psi;
+
+    return sampler->current_ms;
+}
@@ -0,0 +1,306 @@
+// src/slab.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/slab.h"
+#include "../include/procio.h"
+
+#define INITIAL_FILE_BUFFER (64 * 1024)
+#define INITIAL_CACHE_CAPACITY 256
+#define NO_CACHE -1
+
+// Parsed caches for the current and previous sample; swapped each tick
+typedef struct {
+    char *buf;
+    size_t buf_size;
+    SlabCache *caches;
+    SlabCache *prev;
+    int count;
+    int prev_count;
+    int capacity;
+    int *prev_index;            // open-addressed hash of prev[] by name
+    int prev_index_mask;
+    int *index;                 // the same for caches[], built after parsing
+    int index_mask;
+    uint64_t prev_ns;
+    unsigned long total_bytes;
+    long page_size;
+} SlabState;
+
+static SlabState state;
+
+// Read the whole file into the reusable buffer
+static bool read_file(const char *path, size_t *len) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (errno == EACCES) {
+            fprintf(stderr, "Error opening %s: %s (root is required; --slabinfo FILE reads a copy)\n",
+                    path, strerror(errno));
+        } else {
+            fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+        }
+        return false;
+    }
+
+    size_t used = 0;
+    for (;;) {
+        if (used + 1 >= state.buf_size) {
+            size_t size = state.buf_size ? state.buf_size * 2 : INITIAL_FILE_BUFFER;
+            char *buf = realloc(state.buf, size);
+            if (buf == NULL) {
+                close(fd);
+                return false;
+            }
+            state.buf = buf;
+            state.buf_size = size;
+        }
+
+        ssize_t n = read(fd, state.buf + used, state.buf_size - used - 1);
+        procio_count(n > 0 ? (size_t)n : 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error reading %s: %s\n", path, strerror(errno));
+            close(fd);
+            return false;
+        }
+        if (n == 0) break;
+        used += n;
+    }
+
+    close(fd);
+    state.buf[used] = '\0';
+    *len = used;
+    return true;
+}
+
+static bool ensure_capacity(int needed) {
+    if (needed <= state.capacity) {
+        return true;
+    }
+
+    int capacity = state.capacity ? state.capacity : INITIAL_CACHE_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+
+    SlabCache *caches = realloc(state.caches, capacity * sizeof(SlabCache));
+    if (caches == NULL) return false;
+    state.caches = caches;
+
+    SlabCache *prev = realloc(state.prev, capacity * sizeof(SlabCache));
+    if (prev == NULL) return false;
+    state.prev = prev;
+
+    state.capacity = capacity;
+    return true;
+}
+
+static inline const char *skip_spaces(const char *p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+// Parse one cache line:
+// name <active_objs> <num_objs> <objsize> <objperslab> <pagesperslab> : tunables ... : slabdata <active_slabs> <num_slabs> <sharedavail>
+static bool parse_cache_line(const char *line, SlabCache *cache) {
+    const char *p = line;
+    size_t len = strcspn(p, " \t");
+    if (len == 0 || len >= SLAB_NAME_MAX) {
+        return false;
+    }
+    memcpy(cache->name, p, len);
+    cache->name[len] = '\0';
+    p += len;
+
+    unsigned long v[5];
+    char *end;
+    for (int i = 0; i < 5; i++) {
+        const char *start = skip_spaces(p);
+        v[i] = strtoul(start, &end, 10);
+        if (end == start) return false;
+        p = end;
+    }
+
+    const char *slabdata = strstr(p, "slabdata");
+    if (slabdata == NULL) {
+        return false;
+    }
+    strtoul(slabdata + 8, &end, 10);            // active_slabs
+    unsigned long num_slabs = strtoul(end, NULL, 10);
+
+    cache->active_objs = v[0];
+    cache->num_objs = v[1];
+    cache->objsize = v[2];
+    cache->bytes = num_slabs * v[4] * (unsigned long)state.page_size;
+    cache->growth = 0;
+    return true;
+}
+
+// FNV-1a of a cache name
+static uint32_t name_hash(const char *name) {
+    uint32_t hash = 2166136261U;
+    while (*name != '\0') {
+        hash = (hash ^ (unsigned char)*name++) * 16777619U;
+    }
+    return hash;
+}
+
+// Hash caches[] by name with linear probing, at most half full
+static bool build_index(void) {
+    int size = 64;
+    while (size < state.count * 2) size *= 2;
+
+    if (size - 1 > state.index_mask) {
+        int *index = realloc(state.index, size * sizeof(int));
+        if (index == NULL) return false;
+        state.index = index;
+        state.index_mask = size - 1;
+    }
+
+    for (int i = 0; i <= state.index_mask; i++) {
+        state.index[i] = NO_CACHE;
+    }
+    for (int i = 0; i < state.count; i++) {
+        uint32_t slot = name_hash(state.caches[i].name) & (uint32_t)state.index_mask;
+        while (state.index[slot] != NO_CACHE) {
+            slot = (slot + 1) & (uint32_t)state.index_mask;
+        }
+        state.index[slot] = i;
+    }
+    return true;
+}
+
+// Previous sample of the same cache.  The kernel keeps a stable order so
+// the same position almost always matches; otherwise the name hash finds it.
+static const SlabCache *find_previous(int position, const char *name) {
+    if (position < state.prev_count && strcmp(state.prev[position].name, name) == 0) {
+        return &state.prev[position];
+    }
+    if (state.prev_index == NULL) {
+        return NULL;
+    }
+
+    uint32_t slot = name_hash(name) & (uint32_t)state.prev_index_mask;
+    for (int i = state.prev_index[slot]; i != NO_CACHE; i = state.prev_index[slot]) {
+        if (strcmp(state.prev[i].name, name) == 0) {
+            return &state.prev[i];
+        }
+        slot = (slot + 1) & (uint32_t)state.prev_index_mask;
+    }
+    return NULL;
+}
+
+// Public function to parse slabinfo and update per-cache growth rates
+bool slab_sample(const char *path, uint64_t now_ns) {
+    size_t len;
+
+    if (state.page_size == 0) {
+        state.page_size = sysconf(_SC_PAGESIZE);
+    }
+    if (!read_file(path, &len)) {
+        return false;
+    }
+    if (strncmp(state.buf, "slabinfo - version:", 19) != 0) {
+        fprintf(stderr, "Error: %s is not in slabinfo format\n", path);
+        return false;
+    }
+
+    // Keep the last sample around for growth rates
+    SlabCache *tmp = state.prev;
+    state.prev = state.caches;
+    state.caches = tmp;
+    state.prev_count = state.count;
+    state.count = 0;
+
+    int *tmp_index = state.prev_index;
+    int tmp_mask = state.prev_index_mask;
+    state.prev_index = state.index;
+    state.prev_index_mask = state.index_mask;
+    state.index = tmp_index;
+    state.index_mask = tmp_mask;
+    state.total_bytes = 0;
+
+    double elapsed_s = state.prev_ns ? (double)(now_ns - state.prev_ns) / 1e9 : 0;
+    char *line = state.buf;
+
+    while (line != NULL && *line != '\0') {
+        char *next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
+
+        // Skip the version and column header lines
+        if (*line != '#' && strncmp(line, "slabinfo", 8) != 0) {
+            if (!ensure_capacity(state.count + 1)) {
+                fprintf(stderr, "Error: Out of memory parsing %s\n", path);
+                return false;
+            }
+
+            SlabCache *cache = &state.caches[state.count];
+            if (parse_cache_line(line, cache)) {
+                const SlabCache *prev = find_previous(state.count, cache->name);
+                if (prev != NULL && elapsed_s > 0) {
+                    cache->growth = ((double)cache->bytes - (double)prev->bytes) / elapsed_s;
+                }
+                state.total_bytes += cache->bytes;
+                state.count++;
+            }
+        }
+
+        line = next;
+    }
+
+    if (!build_index()) {
+        fprintf(stderr, "Error: Out of memory parsing %s\n", path);
+        return false;
+    }
+    state.prev_ns = now_ns;
+    return true;
+}
+
+// Copy the largest caches into out[], largest first
+int slab_top(SlabCache *out, int max) {
+    const SlabCache *top[SLAB_TOP_COUNT];
+    int count = 0;
+
+    if (max > SLAB_TOP_COUNT) {
+        max = SLAB_TOP_COUNT;
+    }
+
+    for (int i = 0; i < state.count; i++) {
+        const SlabCache *cache = &state.caches[i];
+
+        // Insertion into a short sorted array of pointers: O(caches * max), no full sort
+        if (count == max && top[max - 1]->bytes >= cache->bytes) {
+            continue;
+        }
+        int pos = count < max ? count : max - 1;
+        while (pos > 0 && top[pos - 1]->bytes < cache->bytes) {
+            top[pos] = top[pos - 1];
+            pos--;
+        }
+        top[pos] = cache;
+        if (count < max) count++;
+    }
+
+    for (int i = 0; i < count; i++) {
+        out[i] = *top[i];
+    }
+    return count;
+}
+
+int slab_cache_count(void) {
+    return state.count;
+}
+
+unsigned long slab_total_bytes(void) {
+    return state.total_bytes;
+}
+
+void slab_free(void) {
+    free(state.buf);
+    free(state.caches);
+    free(state.prev);
+    free(state.index);
+    free(state.prev_index);
+    memset(&state, 0, sizeof(state));
+}
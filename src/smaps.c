@@ -0,0 +1,207 @@
+// src/smaps.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <stddef.h>     // For offsetof macro
+#include "../include/smaps.h"
+#include "../include/stream.h"
+#include "../include/procio.h"
+#include "../include/utils.h"
+
+#define SMAPS_TABLE_SIZE (SMAPS_MAX_MAPPINGS * 2)   // power of two, at most half full
+#define KB_TO_BYTES 1024UL
+
+typedef struct {
+    uint32_t hash;
+    bool used;
+    SmapsMapping mapping;
+} MappingSlot;
+
+// Fixed-size aggregation state, reused for every read
+static MappingSlot table[SMAPS_TABLE_SIZE];
+static char arena[SMAPS_NAME_ARENA];
+static size_t arena_used;
+static int mapping_count;
+static SmapsMapping other = {.name = "[other]"};
+
+// Field lines of interest and where their value is accumulated
+typedef struct {
+    const char *name;
+    size_t name_len;
+    size_t offset;
+} SmapsField;
+
+static const SmapsField SMAPS_FIELDS[] = {
+    {"Rss:",           4,  offsetof(SmapsMapping, rss)},
+    {"Pss:",           4,  offsetof(SmapsMapping, pss)},
+    {"Private_Dirty:", 14, offsetof(SmapsMapping, private_dirty)},
+    {"Swap:",          5,  offsetof(SmapsMapping, swap)},
+    {"AnonHugePages:", 14, offsetof(SmapsMapping, anon_huge)}
+};
+#define SMAPS_FIELD_COUNT (sizeof(SMAPS_FIELDS) / sizeof(SMAPS_FIELDS[0]))
+
+static uint32_t hash_name(const char *name, size_t len) {
+    uint32_t hash = 2166136261U;    // FNV-1a
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619U;
+    }
+    return hash;
+}
+
+// Find or create the aggregate for a mapping name
+static SmapsMapping *lookup_mapping(const char *name, size_t len) {
+    uint32_t hash = hash_name(name, len);
+    uint32_t idx = hash & (SMAPS_TABLE_SIZE - 1);
+
+    while (table[idx].used) {
+        const char *existing = table[idx].mapping.name;
+        if (table[idx].hash == hash && strncmp(existing, name, len) == 0 && existing[len] == '\0') {
+            return &table[idx].mapping;
+        }
+        idx = (idx + 1) & (SMAPS_TABLE_SIZE - 1);
+    }
+
+    // Table or name arena exhausted: keep memory bounded by folding the rest together
+    if (mapping_count >= SMAPS_MAX_MAPPINGS || arena_used + len + 1 > sizeof(arena)) {
+        return &other;
+    }
+
+    char *copy = arena + arena_used;
+    memcpy(copy, name, len);
+    copy[len] = '\0';
+    arena_used += len + 1;
+
+    table[idx].used = true;
+    table[idx].hash = hash;
+    table[idx].mapping.name = copy;
+    mapping_count++;
+    return &table[idx].mapping;
+}
+
+// "start-end perms offset dev inode   name": the name is everything after the fifth column
+static void mapping_name(const char *line, const char **name, size_t *len) {
+    const char *p = line;
+    for (int col = 0; col < 5; col++) {
+        while (*p && *p != ' ') p++;
+        while (*p == ' ') p++;
+    }
+
+    if (*p == '\0') {
+        *name = "[anon]";
+        *len = 6;
+    } else {
+        *name = p;
+        *len = strlen(p);
+    }
+}
+
+static unsigned long parse_kb(const char *p) {
+    unsigned long value = 0;
+    while (*p == ' ') p++;
+    while (*p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+    }
+    return value * KB_TO_BYTES;
+}
+
+static void read_comm(pid_t pid, char *comm, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/comm", (int)pid);
+
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL || fgets(comm, size, fp) == NULL) {
+        snprintf(comm, size, "?");
+    } else {
+        procio_count(strlen(comm));
+    }
+    if (fp != NULL) fclose(fp);
+    comm[strcspn(comm, "\n")] = '\0';
+}
+
+// Public function to stream /proc/[pid]/smaps and aggregate it by mapping name
+bool smaps_read(pid_t pid, SmapsSummary *summary) {
+    char path[64];
+    LineStream stream;
+    uint64_t start_ns = monotonic_ns();
+
+    snprintf(path, sizeof(path), "/proc/%d/smaps", (int)pid);
+    if (!stream_open(&stream, path)) {
+        fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    memset(table, 0, sizeof(table));
+    memset(&other, 0, sizeof(other));
+    other.name = "[other]";
+    arena_used = 0;
+    mapping_count = 0;
+
+    memset(summary, 0, sizeof(*summary));
+    summary->pid = pid;
+    summary->total.name = "total";
+    read_comm(pid, summary->comm, sizeof(summary->comm));
+
+    SmapsMapping *current = NULL;
+    char *line;
+    size_t len;
+
+    while ((line = stream_next_line(&stream, &len)) != NULL) {
+        // Field names start with an upper-case letter; VMA headers with a hex address
+        if (!isupper((unsigned char)line[0])) {
+            const char *name;
+            size_t name_len;
+            mapping_name(line, &name, &name_len);
+            current = lookup_mapping(name, name_len);
+            current->vmas++;
+            summary->total.vmas++;
+            continue;
+        }
+        if (current == NULL) {
+            continue;
+        }
+
+        for (size_t i = 0; i < SMAPS_FIELD_COUNT; i++) {
+            const SmapsField *field = &SMAPS_FIELDS[i];
+            if (len > field->name_len && memcmp(line, field->name, field->name_len) == 0) {
+                unsigned long value = parse_kb(line + field->name_len);
+                *(unsigned long *)((char *)current + field->offset) += value;
+                *(unsigned long *)((char *)&summary->total + field->offset) += value;
+                break;
+            }
+        }
+    }
+
+    summary->bytes_parsed = stream.bytes_read;
+    stream_close(&stream);
+
+    summary->mapping_count = mapping_count + (other.vmas > 0);
+    summary->elapsed_s = (double)(monotonic_ns() - start_ns) / 1e9;
+    return true;
+}
+
+// Copy the mappings with the most resident memory into out[], largest first
+int smaps_top(SmapsMapping *out, int max) {
+    int count = 0;
+
+    for (int i = -1; i < SMAPS_TABLE_SIZE; i++) {
+        const SmapsMapping *m = (i < 0) ? &other : &table[i].mapping;
+        if (i >= 0 && !table[i].used) continue;
+        if (m->vmas == 0) continue;
+
+        if (count == max && out[max - 1].rss >= m->rss) {
+            continue;
+        }
+        int pos = count < max ? count : max - 1;
+        while (pos > 0 && out[pos - 1].rss < m->rss) {
+            out[pos] = out[pos - 1];
+            pos--;
+        }
+        out[pos] = *m;
+        if (count < max) count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,102 @@
+// src/stream.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../include/stream.h"
+#include "../include/procio.h"
+
+bool stream_open(LineStream *stream, const char *path) {
+    memset(stream, 0, sizeof(*stream));
+
+    stream->fd = open(path, O_RDONLY);
+    if (stream->fd < 0) {
+        return false;
+    }
+
+    stream->buf = malloc(STREAM_CHUNK_SIZE);
+    if (stream->buf == NULL) {
+        close(stream->fd);
+        stream->fd = -1;
+        errno = ENOMEM;
+        return false;
+    }
+    return true;
+}
+
+// Refill after moving the partial line at the end of the buffer to the front
+static bool stream_fill(LineStream *stream) {
+    size_t pending = stream->end - stream->start;
+    if (pending > 0 && stream->start > 0) {
+        memmove(stream->buf, stream->buf + stream->start, pending);
+    }
+    stream->start = 0;
+    stream->end = pending;
+
+    while (!stream->eof && stream->end < STREAM_CHUNK_SIZE - 1) {
+        ssize_t n = read(stream->fd, stream->buf + stream->end,
+                         STREAM_CHUNK_SIZE - 1 - stream->end);
+        procio_count(n > 0 ? (size_t)n : 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) {
+            stream->eof = true;
+            break;
+        }
+        stream->end += n;
+        stream->bytes_read += n;
+
+        // One read per refill is enough unless it ended mid-line
+        if (memchr(stream->buf + pending, '\n', stream->end - pending) != NULL) {
+            break;
+        }
+    }
+    return true;
+}
+
+// Return the next line without its newline, or NULL at end of file.  The
+// pointer stays valid until the next call.  Lines longer than the chunk
+// buffer are split.
+char *stream_next_line(LineStream *stream, size_t *len) {
+    char *line = stream->buf + stream->start;
+    char *nl = memchr(line, '\n', stream->end - stream->start);
+
+    if (nl == NULL) {
+        if (!stream_fill(stream)) {
+            return NULL;
+        }
+        line = stream->buf;
+        nl = memchr(line, '\n', stream->end);
+        if (nl == NULL) {
+            if (stream->end == 0) {
+                return NULL;
+            }
+            nl = line + stream->end;    // last line without newline, or overlong line
+        }
+    }
+
+    size_t line_len = nl - line;
+    line[line_len] = '\0';
+    stream->start += line_len + 1;
+    if (stream->start > stream->end) {
+        stream->start = stream->end;
+    }
+
+    if (len != NULL) {
+        *len = line_len;
+    }
+    return line;
+}
+
+void stream_close(LineStream *stream) {
+    if (stream->fd >= 0) {
+        close(stream->fd);
+    }
+    free(stream->buf);
+    stream->buf = NULL;
+    stream->fd = -1;
+}
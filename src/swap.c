@@ -0,0 +1,208 @@
+// src/swap.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <limits.h>
+#include <stdbool.h>
+#include "../include/swap.h"
+#include "../include/procio.h"
+
+#define SWAPS_PATH "/proc/swaps"
+#define SYS_BLOCK_PATH "/sys/block"
+#define KB_TO_BYTES 1024UL
+
+// Copy the next whitespace-delimited field; fails rather than truncating
+static bool copy_field(const char **pos, char *out, size_t size) {
+    const char *start = *pos + strspn(*pos, " \t");
+    size_t len = strcspn(start, " \t\n");
+
+    if (len == 0 || len >= size) {
+        return false;
+    }
+    memcpy(out, start, len);
+    out[len] = '\0';
+    *pos = start + len;
+    return true;
+}
+
+// Parse one data line of /proc/swaps: "Filename Type Size Used Priority".
+// The kernel escapes whitespace in the filename, so it is a single field.
+static bool parse_swaps_line(const char *line, SwapDevice *dev) {
+    unsigned long size_kb, used_kb;
+
+    if (!copy_field(&line, dev->name, sizeof(dev->name)) ||
+        !copy_field(&line, dev->type, sizeof(dev->type)) ||
+        sscanf(line, "%lu %lu %d", &size_kb, &used_kb, &dev->priority) != 3) {
+        return false;
+    }
+
+    if (size_kb > ULONG_MAX / KB_TO_BYTES) {
+        return false;
+    }
+    dev->size = size_kb * KB_TO_BYTES;
+    dev->used = used_kb * KB_TO_BYTES;
+    return true;
+}
+
+static void read_proc_swaps(SwapDetails *details) {
+    static int handle = -1;
+    static bool unavailable = false;
+
+    if (handle < 0 && !unavailable) {
+        handle = procio_register(SWAPS_PATH);
+        // Kernels built without swap support have no /proc/swaps
+        unavailable = handle < 0;
+    }
+
+    const char *data = handle >= 0 ? procio_read(handle, NULL) : NULL;
+    if (data == NULL) {
+        return;
+    }
+
+    // Skip the header line
+    const char *line = strchr(data, '\n');
+
+    while (line != NULL && *++line != '\0' && details->device_count < MAX_SWAP_DEVICES) {
+        SwapDevice *dev = &details->devices[details->device_count];
+        if (parse_swaps_line(line, dev)) {
+            details->device_count++;
+        } else {
+            fprintf(stderr, "Error parsing line: %.*s\n", (int)strcspn(line, "\n"), line);
+        }
+        line = strchr(line, '\n');
+    }
+}
+
+// mm_stat: orig_data_size compr_data_size mem_used_total mem_limit ...
+static bool read_zram_mm_stat(int handle, const char *name, ZramDevice *zram) {
+    const char *data = procio_read(handle, NULL);
+    if (data == NULL) {
+        return false;
+    }
+
+    if (sscanf(data, "%lu %lu %lu", &zram->orig_data_size, &zram->compr_data_size,
+               &zram->mem_used_total) != 3) {
+        return false;
+    }
+
+    snprintf(zram->name, sizeof(zram->name), "%s", name);
+    return true;
+}
+
+// FNV-1a over the swap device names; changes when swapon/swapoff alter the set
+static unsigned long swap_set_signature(const SwapDetails *details) {
+    unsigned long hash = 2166136261UL;
+    for (int i = 0; i < details->device_count; i++) {
+        for (const char *c = details->devices[i].name; *c != '\0'; c++) {
+            hash = (hash ^ (unsigned char)*c) * 16777619UL;
+        }
+        hash = (hash ^ '\n') * 16777619UL;
+    }
+    return hash;
+}
+
+// zram devices are rediscovered whenever the set of swap devices changes; their
+// mm_stat files then join the per-tick batch (procio_register reuses open paths)
+static void read_zram_devices(SwapDetails *details) {
+    static char names[MAX_ZRAM_DEVICES][16];
+    static int handles[MAX_ZRAM_DEVICES];
+    static int count = -1;
+    static unsigned long signature;
+
+    unsigned long current = swap_set_signature(details);
+    if (count < 0 || current != signature) {
+        signature = current;
+        count = 0;
+        DIR *dir = opendir(SYS_BLOCK_PATH);
+        struct dirent *entry;
+
+        while (dir != NULL && (entry = readdir(dir)) != NULL && count < MAX_ZRAM_DEVICES) {
+            if (strncmp(entry->d_name, "zram", 4) != 0 || strlen(entry->d_name) >= sizeof(names[0])) {
+                continue;
+            }
+
+            char path[PATH_MAX];
+            snprintf(path, sizeof(path), "%s/%s/mm_stat", SYS_BLOCK_PATH, entry->d_name);
+            handles[count] = procio_register(path);
+            if (handles[count] >= 0) {
+                memcpy(names[count], entry->d_name, strlen(entry->d_name) + 1);
+                count++;
+            }
+        }
+        if (dir != NULL) closedir(dir);
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (read_zram_mm_stat(handles[i], names[i], &details->zram[details->zram_count])) {
+            details->zram_count++;
+        }
+    }
+}
+
+// Match a /proc/swaps entry such as "/dev/zram0" to its mm_stat
+const ZramDevice *find_zram_device(const SwapDetails *details, const SwapDevice *dev) {
+    const char *base = strrchr(dev->name, '/');
+    base = base ? base + 1 : dev->name;
+
+    for (int i = 0; i < details->zram_count; i++) {
+        if (strcmp(details->zram[i].name, base) == 0) {
+            return &details->zram[i];
+        }
+    }
+    return NULL;
+}
+
+static bool is_swap_device(const SwapDetails *details, const char *zram_name) {
+    for (int i = 0; i < details->device_count; i++) {
+        const char *base = strrchr(details->devices[i].name, '/');
+        base = base ? base + 1 : details->devices[i].name;
+        if (strcmp(base, zram_name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double compression_ratio(unsigned long orig, unsigned long compressed) {
+    return compressed ? (double)orig / compressed : 0.0;
+}
+
+// RAM consumed by compressed swap: zram allocator pools plus the zswap pool
+unsigned long swap_ram_cost(const SwapDetails *details) {
+    unsigned long cost = details->zswap;
+    for (int i = 0; i < details->zram_count; i++) {
+        cost += details->zram[i].mem_used_total;
+    }
+    return cost;
+}
+
+// Public function to collect per-device swap usage and compression stats
+bool get_swap_details(const MemoryInfo *info, SwapDetails *details) {
+    memset(details, 0, sizeof(*details));
+
+    details->zswap = info->zswap;
+    details->zswapped = info->zswapped;
+
+    read_proc_swaps(details);
+    read_zram_devices(details);
+
+    // Report zram devices as such even though /proc/swaps calls them partitions
+    for (int i = 0; i < details->device_count; i++) {
+        if (find_zram_device(details, &details->devices[i]) != NULL) {
+            snprintf(details->devices[i].type, sizeof(details->devices[i].type), "zram");
+        }
+    }
+
+    // zram devices that are unconfigured or hold a filesystem are not swap
+    int kept = 0;
+    for (int i = 0; i < details->zram_count; i++) {
+        if (is_swap_device(details, details->zram[i].name)) {
+            details->zram[kept++] = details->zram[i];
+        }
+    }
+    details->zram_count = kept;
+
+    return details->device_count > 0 || details->zram_count > 0 || details->zswapped > 0;
+}
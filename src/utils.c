@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "utils.h"
 #include "args.h"
 
@@ -70,4 +71,17 @@ void format_size(unsigned long bytes, char *result, size_t result_size, const Pr
     if (written >= (int)result_size) {
         result[result_size - 1] = '\0';
     }
-}
\ No newline at end of file
+}
+
+uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+
+    // An interrupting signal ends the sleep early so SIGINT is handled promptly
+    nanosleep(&ts, NULL);
+}
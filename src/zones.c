@@ -0,0 +1,199 @@
+// src/zones.c
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "../include/zones.h"
+#include "../include/stream.h"
+#include "../include/utils.h"
+
+static ZoneReport report;
+
+// "Node 0, zone   Normal": shared header of zoneinfo and buddyinfo lines.
+// Returns a pointer past the zone name, or NULL for other lines.
+static const char *parse_zone_header(const char *line, int *node, char *name) {
+    char *end;
+
+    if (strncmp(line, "Node ", 5) != 0) {
+        return NULL;
+    }
+    long value = strtol(line + 5, &end, 10);
+    if (end == line + 5 || strncmp(end, ", zone", 6) != 0) {
+        return NULL;
+    }
+
+    const char *p = end + 6;
+    while (*p == ' ') p++;
+    int len = 0;
+    while (p[len] && p[len] != ' ' && p[len] != '\n' && len < ZONE_NAME_MAX - 1) {
+        name[len] = p[len];
+        len++;
+    }
+    name[len] = '\0';
+    *node = (int)value;
+    return p + len;
+}
+
+static unsigned long parse_pages(const char *p) {
+    unsigned long value = 0;
+    while (*p == ' ') p++;
+    while (*p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+    }
+    return value;
+}
+
+static bool key_is(const char *p, const char *key, size_t key_len) {
+    return strncmp(p, key, key_len) == 0 && p[key_len] == ' ';
+}
+
+// Only the zone header and five indented keys matter; everything else
+// (per-node vmstat counters, pagesets) is rejected on its first character
+static void parse_zoneinfo_line(const char *line, ZoneStats **zone) {
+    if (line[0] == 'N') {
+        // Unpopulated zones (Movable, Device) give their slot back
+        if (*zone != NULL && (*zone)->managed == 0) {
+            report.count--;
+        }
+
+        ZoneStats *next = report.count < ZONES_MAX ? &report.zones[report.count] : NULL;
+        char name[ZONE_NAME_MAX];
+        int node;
+
+        *zone = NULL;
+        if (next != NULL && parse_zone_header(line, &node, name) != NULL) {
+            memset(next, 0, sizeof(*next));
+            next->node = node;
+            memcpy(next->name, name, sizeof(name));
+            report.count++;
+            *zone = next;
+        }
+        return;
+    }
+    if (*zone == NULL) {
+        return;
+    }
+
+    const char *p = line;
+    while (*p == ' ') p++;
+
+    switch (*p) {
+        case 'p':
+            if (key_is(p, "pages", 5)) {
+                p += 5;
+                while (*p == ' ') p++;
+                if (key_is(p, "free", 4)) (*zone)->free = parse_pages(p + 4);
+            }
+            break;
+        case 'm':
+            if (key_is(p, "min", 3)) (*zone)->min = parse_pages(p + 3);
+            else if (key_is(p, "managed", 7)) (*zone)->managed = parse_pages(p + 7);
+            break;
+        case 'l':
+            if (key_is(p, "low", 3)) (*zone)->low = parse_pages(p + 3);
+            break;
+        case 'h':
+            if (key_is(p, "high", 4)) (*zone)->high = parse_pages(p + 4);
+            break;
+        default:
+            break;
+    }
+}
+
+// buddyinfo lists zones in zoneinfo order, so try the slot after the last hit first
+static ZoneStats *find_zone(int node, const char *name, int *hint) {
+    for (int n = 0; n < report.count; n++) {
+        int i = (*hint + n) % report.count;
+        if (report.zones[i].node == node && strcmp(report.zones[i].name, name) == 0) {
+            *hint = i + 1;
+            return &report.zones[i];
+        }
+    }
+    return NULL;
+}
+
+// Unusable free space index: the share of free pages sitting in blocks
+// smaller than 2^order, which cannot serve an allocation of that order
+static void compute_unusable(ZoneStats *zone) {
+    unsigned long total = 0;
+    for (int order = 0; order < zone->orders; order++) {
+        total += zone->blocks[order] << order;
+    }
+
+    unsigned long smaller = 0;
+    for (int order = 0; order < zone->orders; order++) {
+        zone->unusable[order] = total ? (double)smaller / total : 0;
+        smaller += zone->blocks[order] << order;
+    }
+}
+
+// One line per populated zone: "Node 0, zone   Normal   2796    391 ..."
+static void parse_buddyinfo_line(const char *line, int *hint) {
+    char name[ZONE_NAME_MAX];
+    int node;
+    const char *p = parse_zone_header(line, &node, name);
+    ZoneStats *zone = p != NULL && report.count > 0 ? find_zone(node, name, hint) : NULL;
+    if (zone == NULL) {
+        return;
+    }
+
+    char *end;
+    zone->orders = 0;
+    while (zone->orders < ZONE_ORDERS) {
+        unsigned long blocks = strtoul(p, &end, 10);
+        if (end == p) break;
+        zone->blocks[zone->orders++] = blocks;
+        p = end;
+    }
+    compute_unusable(zone);
+}
+
+// Both files grow with the node count, so both are streamed
+static bool stream_file(const char *path, void (*parse)(const char *line, void *state), void *state) {
+    LineStream stream;
+    char *line;
+
+    if (!stream_open(&stream, path)) {
+        fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    while ((line = stream_next_line(&stream, NULL)) != NULL) {
+        parse(line, state);
+    }
+    report.bytes_parsed += stream.bytes_read;
+    stream_close(&stream);
+    return true;
+}
+
+static void zoneinfo_callback(const char *line, void *state) {
+    parse_zoneinfo_line(line, state);
+}
+
+static void buddyinfo_callback(const char *line, void *state) {
+    parse_buddyinfo_line(line, state);
+}
+
+// Public function to sample per-zone watermarks and buddy free lists
+const ZoneReport *zones_read(const char *zoneinfo_path, const char *buddyinfo_path) {
+    uint64_t start_ns = monotonic_ns();
+    ZoneStats *zone = NULL;
+    int hint = 0;
+
+    report.count = 0;
+    report.bytes_parsed = 0;
+    report.page_size = sysconf(_SC_PAGESIZE);
+
+    if (!stream_file(zoneinfo_path, zoneinfo_callback, &zone)) {
+        return NULL;
+    }
+    if (zone != NULL && zone->managed == 0) {
+        report.count--;
+    }
+    if (!stream_file(buddyinfo_path, buddyinfo_callback, &hint)) {
+        return NULL;
+    }
+
+    report.elapsed_s = (double)(monotonic_ns() - start_ns) / 1e9;
+    return &report;
+}